@@ -1,6 +1,27 @@
 #include <iostream>
 #include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
 #include <ctime>
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#ifdef __linux__
+#include <pthread.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 using namespace std;
 // TASK CLASS
@@ -13,6 +34,9 @@ public:
     int duration;           // Hours required to complete
     Task* next;             // Pointer to next task in list
     Task* queueNext;        // Pointer for queue operations
+    Task* previous;         // Pointer to previous task (pending list only)
+    Task* waitNext;         // Next pending task waiting on the same conflict window
+    bool isTombstone;       // Node is dead and only waits for compaction
     // Constructor to initialize a task
     Task() {
         id = 0;
@@ -22,6 +46,9 @@ public:
         duration = 0;
         next = nullptr;
         queueNext = nullptr;
+        previous = nullptr;
+        waitNext = nullptr;
+        isTombstone = false;
     }
 
     // Display task details
@@ -66,16 +93,27 @@ public:
 // STACK CLASS FOR UNDO OPERATIONS
 class UndoStack {
 private:
-    Task* taskStack[100];   // Array to store pointers to tasks
+    Task** taskStack;       // Array of 100 task pointers, allocated on first push
     int stackTop;           // Index of top element
 
 public:
     // Constructor
     UndoStack() {
+        taskStack = nullptr;
         stackTop = -1;
     }
+    // Destructor to clean up memory
+    ~UndoStack() {
+        while (stackTop >= 0) {
+            delete taskStack[stackTop--];
+        }
+        delete[] taskStack;
+    }
     // Push a task onto the undo stack
     void pushTask(Task* task) {
+        if (!taskStack) {
+            taskStack = new Task*[100];
+        }
         if (stackTop < 99) {
             taskStack[++stackTop] = task->createCopy();
         }
@@ -115,8 +153,8 @@ public:
     ~PriorityQueue() {
         clearQueue();
     }
-    // Add a task to the queue
-    void enqueueTask(Task* newTask) {
+    // Add a task to the queue, returns the queued copy
+    Task* enqueueTask(Task* newTask) {
         Task* taskCopy = newTask->createCopy();
         taskCopy->queueNext = nullptr;
         if (isEmpty()) {
@@ -127,6 +165,48 @@ public:
             rearPointer = taskCopy;
         }
         taskCount++;
+        return taskCopy;
+    }
+    // A queued copy was tombstoned, it no longer counts as queued
+    void noteTombstone() {
+        taskCount--;
+    }
+    // Delete every tombstoned copy, returns how many were removed
+    int removeTombstones() {
+        int removedCount = 0;
+        Task* previousTask = nullptr;
+        Task* current = frontPointer;
+        while (current) {
+            Task* nextTask = current->queueNext;
+            if (current->isTombstone) {
+                if (previousTask) {
+                    previousTask->queueNext = nextTask;
+                } else {
+                    frontPointer = nextTask;
+                }
+                delete current;
+                removedCount++;
+            } else {
+                previousTask = current;
+            }
+            current = nextTask;
+        }
+        rearPointer = previousTask;
+        return removedCount;
+    }
+    // Append an already linked chain of task copies (first..last via queueNext)
+    void appendTaskChain(Task* first, Task* last, int chainLength) {
+        if (!first) {
+            return;
+        }
+        last->queueNext = nullptr;
+        if (isEmpty()) {
+            frontPointer = first;
+        } else {
+            rearPointer->queueNext = first;
+        }
+        rearPointer = last;
+        taskCount += chainLength;
     }
     // Remove and return a task from the queue
     Task* dequeueTask() {
@@ -156,7 +236,7 @@ public:
     }
     // Display all tasks in this queue
     void displayQueueTasks() {
-        if (isEmpty()) {
+        if (taskCount == 0) {
             cout << "    Queue is empty." << endl;
             return;
         }
@@ -164,10 +244,12 @@ public:
         int taskNumber = 1;
         
         while (current) {
-            cout << "    " << taskNumber << ". " << current->name 
-                 << " (Deadline: " << current->deadline << " days)" << endl;
+            if (!current->isTombstone) {
+                cout << "    " << taskNumber << ". " << current->name 
+                     << " (Deadline: " << current->deadline << " days)" << endl;
+                taskNumber++;
+            }
             current = current->queueNext;
-            taskNumber++;
         }
     }
     // Clear all tasks from queue
@@ -178,28 +260,1000 @@ public:
         }
     }
 };
+// Index of a (priority, deadline) slot in the conflict window tables
+int conflictSlotIndex(int priority, int deadline) {
+    return (priority - 1) * 31 + deadline;
+}
+// PERSISTENT SCHEDULE VERSIONS
+// A version is a snapshot of every task and whether it is scheduled, pending or
+// neither. Tasks live in a 16-way radix trie keyed by task ID whose nodes and
+// records are reference counted and never changed once shared: a write copies
+// only the path from the root to one task, so a fork is O(1) and a what-if
+// variant costs only the tasks it changes. Versions are not thread safe, each
+// one belongs to the thread that owns its TaskManager.
+// State of a task inside a schedule version
+enum VersionTaskState {
+    TASK_STATE_UNSCHEDULED = 0,
+    TASK_STATE_SCHEDULED = 1,
+    TASK_STATE_PENDING = 2
+};
+// VERSION TASK CLASS
+class VersionTask {
+public:
+    int refCount;           // Versions and nodes sharing this record
+    int id;
+    char name[100];
+    int priority;
+    int deadline;
+    int duration;
+    int state;              // VersionTaskState
+    int slotPriority;       // Conflict slot held while scheduled (a live task keeps the
+    int slotDeadline;       // slot it was scheduled with even if it is updated later)
+    // Constructor
+    VersionTask() {
+        refCount = 1;
+        id = 0;
+        strcpy(name, "");
+        priority = 0;
+        deadline = 0;
+        duration = 0;
+        state = TASK_STATE_UNSCHEDULED;
+        slotPriority = 0;
+        slotDeadline = 0;
+    }
+    // Create an unshared copy that can be changed
+    VersionTask* createCopy() {
+        VersionTask* newTask = new VersionTask();
+        newTask->id = id;
+        strcpy(newTask->name, name);
+        newTask->priority = priority;
+        newTask->deadline = deadline;
+        newTask->duration = duration;
+        newTask->state = state;
+        newTask->slotPriority = slotPriority;
+        newTask->slotDeadline = slotDeadline;
+        return newTask;
+    }
+};
+// VERSION NODE CLASS
+class VersionNode {
+public:
+    int refCount;                   // Parents (or version roots) pointing here
+    int waitingCount;               // Tasks below this node that are not scheduled
+    VersionNode* children[16];      // Child nodes (upper levels)
+    VersionTask* tasks[16];         // Task records (bottom level)
+    // Constructor
+    VersionNode() {
+        refCount = 1;
+        waitingCount = 0;
+        for (int i = 0; i < 16; i++) {
+            children[i] = nullptr;
+            tasks[i] = nullptr;
+        }
+    }
+};
+// SCHEDULE VERSION CLASS
+class ScheduleVersion {
+private:
+    VersionNode* root;              // Trie root (nullptr while empty)
+    int levelCount;                 // Trie height, each level holds 4 bits of the ID
+    int taskCount;
+    int scheduledCount;
+    int pendingCount;
+    int slotCounts[5 * 31];         // Scheduled tasks per (priority, deadline) slot
+    int nextTaskId;                 // ID given to the next task added to this version
+    long long baseGeneration;       // Live generation this version was forked from
+    // Drop one reference to a record
+    static void releaseTask(VersionTask* task) {
+        if (task && --task->refCount == 0) {
+            delete task;
+        }
+    }
+    // Drop one reference to a node, freeing the subtree nobody else shares
+    static void releaseNode(VersionNode* node, int level) {
+        if (!node || --node->refCount > 0) {
+            return;
+        }
+        for (int i = 0; i < 16; i++) {
+            if (level > 0) {
+                releaseNode(node->children[i], level - 1);
+            } else {
+                releaseTask(node->tasks[i]);
+            }
+        }
+        delete node;
+    }
+    // Make the node in a slot safe to change: shared nodes are copied (the copy
+    // shares all children), a node only this version holds is changed in place
+    static VersionNode* makeWritable(VersionNode*& slot) {
+        VersionNode* node = slot;
+        if (!node) {
+            slot = new VersionNode();
+            return slot;
+        }
+        if (node->refCount == 1) {
+            return node;
+        }
+        VersionNode* copy = new VersionNode();
+        copy->waitingCount = node->waitingCount;
+        for (int i = 0; i < 16; i++) {
+            copy->children[i] = node->children[i];
+            if (copy->children[i]) {
+                copy->children[i]->refCount++;
+            }
+            copy->tasks[i] = node->tasks[i];
+            if (copy->tasks[i]) {
+                copy->tasks[i]->refCount++;
+            }
+        }
+        node->refCount--;
+        slot = copy;
+        return copy;
+    }
+    // A task that is not scheduled is a candidate for the next scheduling run
+    static int isWaiting(VersionTask* task) {
+        return (task && task->state != TASK_STATE_SCHEDULED) ? 1 : 0;
+    }
+    // Add (sign 1) or remove (sign -1) a record from the counters
+    void countTask(VersionTask* task, int sign) {
+        if (!task) {
+            return;
+        }
+        taskCount += sign;
+        if (task->state == TASK_STATE_SCHEDULED) {
+            scheduledCount += sign;
+            slotCounts[conflictSlotIndex(task->slotPriority, task->slotDeadline)] += sign;
+        } else if (task->state == TASK_STATE_PENDING) {
+            pendingCount += sign;
+        }
+    }
+    // Put a record (or nullptr to remove) at an ID, copying the path to it.
+    // Takes over the caller's reference to the record.
+    void storeTask(int taskId, VersionTask* record) {
+        reserveLevels(taskId);
+        VersionNode* path[8];
+        VersionNode** slot = &root;
+        VersionTask* oldRecord = nullptr;
+        for (int level = levelCount - 1; level >= 0; level--) {
+            VersionNode* node = makeWritable(*slot);
+            path[level] = node;
+            int digit = (taskId >> (4 * level)) & 15;
+            if (level > 0) {
+                slot = &node->children[digit];
+            } else {
+                oldRecord = node->tasks[digit];
+                node->tasks[digit] = record;
+            }
+        }
+        int waitingChange = isWaiting(record) - isWaiting(oldRecord);
+        if (waitingChange != 0) {
+            for (int level = 0; level < levelCount; level++) {
+                path[level]->waitingCount += waitingChange;
+            }
+        }
+        countTask(oldRecord, -1);
+        countTask(record, 1);
+        releaseTask(oldRecord);
+    }
+    // Check whether a scheduled task holds the conflict window of (priority, deadline)
+    bool isWindowOccupied(int priority, int deadline) {
+        for (int day = deadline - 2; day <= deadline + 2; day++) {
+            if (day >= 1 && day <= 30 && slotCounts[conflictSlotIndex(priority, day)] > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // Collect every task that is not scheduled in ID order, skipping subtrees without any
+    static void collectWaitingTasks(VersionNode* node, int level, VersionTask** output, int& found) {
+        if (!node || node->waitingCount == 0) {
+            return;
+        }
+        for (int i = 0; i < 16; i++) {
+            if (level > 0) {
+                collectWaitingTasks(node->children[i], level - 1, output, found);
+            } else if (isWaiting(node->tasks[i])) {
+                output[found++] = node->tasks[i];
+            }
+        }
+    }
+    // Display the tasks in one state in ID order
+    static void displayTasksInOrder(VersionNode* node, int level, int state, int& taskNumber) {
+        if (!node) {
+            return;
+        }
+        for (int i = 0; i < 16; i++) {
+            if (level > 0) {
+                displayTasksInOrder(node->children[i], level - 1, state, taskNumber);
+                continue;
+            }
+            VersionTask* record = node->tasks[i];
+            if (!record || record->state != state) {
+                continue;
+            }
+            Task details;
+            details.id = record->id;
+            strcpy(details.name, record->name);
+            details.priority = record->priority;
+            details.deadline = record->deadline;
+            details.duration = record->duration;
+            details.displayTask(taskNumber++, state == TASK_STATE_SCHEDULED);
+        }
+    }
+public:
+    // Constructor
+    ScheduleVersion() {
+        root = nullptr;
+        levelCount = 1;
+        taskCount = 0;
+        scheduledCount = 0;
+        pendingCount = 0;
+        for (int i = 0; i < 5 * 31; i++) {
+            slotCounts[i] = 0;
+        }
+        nextTaskId = 1;
+        baseGeneration = 0;
+    }
+    // Destructor, frees only what no other version shares
+    ~ScheduleVersion() {
+        releaseNode(root, levelCount - 1);
+    }
+    // O(1) fork: the new version shares the whole trie until either side writes
+    ScheduleVersion* fork() {
+        ScheduleVersion* version = new ScheduleVersion();
+        version->adopt(this);
+        return version;
+    }
+    // Become a copy of another version, sharing its trie
+    void adopt(ScheduleVersion* other) {
+        if (other->root) {
+            other->root->refCount++;
+        }
+        releaseNode(root, levelCount - 1);
+        root = other->root;
+        levelCount = other->levelCount;
+        taskCount = other->taskCount;
+        scheduledCount = other->scheduledCount;
+        pendingCount = other->pendingCount;
+        memcpy(slotCounts, other->slotCounts, sizeof(slotCounts));
+        nextTaskId = other->nextTaskId;
+        baseGeneration = other->baseGeneration;
+    }
+    // Grow the trie until it can hold the given ID
+    void reserveLevels(int taskId) {
+        while (levelCount < 8 && (taskId >> (4 * levelCount)) != 0) {
+            if (root) {
+                VersionNode* newRoot = new VersionNode();
+                newRoot->children[0] = root;
+                newRoot->waitingCount = root->waitingCount;
+                root = newRoot;
+            }
+            levelCount++;
+        }
+    }
+    // Store a new record for its task ID, the version takes ownership of it
+    void putTask(VersionTask* record) {
+        storeTask(record->id, record);
+    }
+    // Remove a task from this version
+    void removeTask(int taskId) {
+        if (findTask(taskId)) {
+            storeTask(taskId, nullptr);
+        }
+    }
+    // Find a task by ID, nullptr if this version does not have it
+    VersionTask* findTask(int taskId) {
+        if (taskId < 1 || (levelCount < 8 && (taskId >> (4 * levelCount)) != 0)) {
+            return nullptr;
+        }
+        VersionNode* node = root;
+        for (int level = levelCount - 1; node && level > 0; level--) {
+            node = node->children[(taskId >> (4 * level)) & 15];
+        }
+        return node ? node->tasks[taskId & 15] : nullptr;
+    }
+    // What-if: add a task, returns its ID (0 if invalid)
+    int addTask(const char* name, int priority, int deadline, int duration) {
+        if (priority < 1 || priority > 5 || deadline < 1 || deadline > 30 ||
+            duration < 1 || duration > 24) {
+            return 0;
+        }
+        VersionTask* record = new VersionTask();
+        record->id = nextTaskId++;
+        strncpy(record->name, name, 99);
+        record->name[99] = '\0';
+        record->priority = priority;
+        record->deadline = deadline;
+        record->duration = duration;
+        putTask(record);
+        return record->id;
+    }
+    // What-if: change the priority and deadline of a task (out-of-range values keep
+    // the current value). A task that moves is unscheduled so the next run places it again.
+    bool updateTask(int taskId, int newPriority, int newDeadline) {
+        VersionTask* current = findTask(taskId);
+        if (!current) {
+            return false;
+        }
+        VersionTask* record = current->createCopy();
+        if (newPriority >= 1 && newPriority <= 5) {
+            record->priority = newPriority;
+        }
+        if (newDeadline >= 1 && newDeadline <= 30) {
+            record->deadline = newDeadline;
+        }
+        if (record->priority == current->priority && record->deadline == current->deadline) {
+            delete record;
+            return true;
+        }
+        record->state = TASK_STATE_UNSCHEDULED;
+        storeTask(taskId, record);
+        return true;
+    }
+    // Same rules as TaskManager::scheduleAllTasks: every task that is not scheduled is
+    // tried by priority, then deadline, then ID, and scheduled if its window is free.
+    // Only the tasks whose state changes are copied.
+    void scheduleAllTasks(int& scheduledNow, int& pendingNow) {
+        scheduledNow = 0;
+        pendingNow = 0;
+        int waitingTotal = root ? root->waitingCount : 0;
+        if (waitingTotal == 0) {
+            return;
+        }
+        VersionTask** candidates = new VersionTask*[waitingTotal];
+        int found = 0;
+        collectWaitingTasks(root, levelCount - 1, candidates, found);
+        // Counting sort by slot keeps the ID order inside each slot
+        int slotStarts[5 * 31 + 1];
+        for (int i = 0; i <= 5 * 31; i++) {
+            slotStarts[i] = 0;
+        }
+        for (int i = 0; i < found; i++) {
+            slotStarts[conflictSlotIndex(candidates[i]->priority, candidates[i]->deadline) + 1]++;
+        }
+        for (int i = 1; i <= 5 * 31; i++) {
+            slotStarts[i] += slotStarts[i - 1];
+        }
+        VersionTask** sortedTasks = new VersionTask*[found];
+        for (int i = 0; i < found; i++) {
+            sortedTasks[slotStarts[conflictSlotIndex(candidates[i]->priority, candidates[i]->deadline)]++] = candidates[i];
+        }
+        delete[] candidates;
+        for (int i = 0; i < found; i++) {
+            VersionTask* current = sortedTasks[i];
+            int newState;
+            if (!isWindowOccupied(current->priority, current->deadline)) {
+                newState = TASK_STATE_SCHEDULED;
+                scheduledNow++;
+            } else {
+                newState = TASK_STATE_PENDING;
+                pendingNow++;
+            }
+            if (current->state != newState) {
+                VersionTask* record = current->createCopy();
+                record->state = newState;
+                record->slotPriority = record->priority;
+                record->slotDeadline = record->deadline;
+                storeTask(record->id, record);
+            }
+        }
+        delete[] sortedTasks;
+    }
+    // Display the scheduled or pending tasks of this version
+    void displayTasks(int state, const string& listName) {
+        int stateCount = state == TASK_STATE_SCHEDULED ? scheduledCount : pendingCount;
+        if (stateCount == 0) {
+            cout << "\nNo tasks in " << listName << " list." << endl;
+            return;
+        }
+        cout << "\n=== " << listName << " ===" << endl;
+        int taskNumber = 1;
+        displayTasksInOrder(root, levelCount - 1, state, taskNumber);
+    }
+    // Accessors
+    VersionNode* getRoot() {
+        return root;
+    }
+    int getLevelCount() {
+        return levelCount;
+    }
+    int getTaskCount() {
+        return taskCount;
+    }
+    int getScheduledCount() {
+        return scheduledCount;
+    }
+    int getPendingCount() {
+        return pendingCount;
+    }
+    int getNextTaskId() {
+        return nextTaskId;
+    }
+    void setNextTaskId(int taskId) {
+        nextTaskId = taskId;
+    }
+    long long getBaseGeneration() {
+        return baseGeneration;
+    }
+    void setBaseGeneration(long long generation) {
+        baseGeneration = generation;
+    }
+};
+// SHARED MEMORY TASK VIEW
+// A TaskManager can publish its tasks into a POSIX shared memory segment that
+// other local processes map read-only. Records are indexed by task ID and are
+// rewritten in place when a task changes. The header holds a sequence counter
+// (seqlock) that is odd while the owner is writing. A reader reads what it
+// needs straight from the mapping, then keeps the result only if the counter
+// was even and did not change. Readers never block the scheduler thread.
+const unsigned int SHARED_VIEW_MAGIC = 0x56545353;     // "SSTV"
+const unsigned int SHARED_VIEW_LAYOUT = 1;             // Bumped when the layout changes
+const int DEFAULT_SHARED_VIEW_CAPACITY = 65536;
+const int SHARED_VIEW_SPIN_RETRIES = 100;              // Reader yields this often, then sleeps 1 ms
+const int MAX_SHARED_VIEW_RETRIES = 5000;              // Reader gives up after about 5 s
+// Header at the start of the segment
+class SharedViewHeader {
+public:
+    unsigned int magic;
+    unsigned int layoutVersion;
+    atomic<unsigned int> sequence;      // Odd while an update is in progress
+    unsigned int capacity;              // Task records after the header, for IDs 1..capacity
+    unsigned int highestId;             // No record above this ID is in use
+    unsigned int allCount;
+    unsigned int scheduledCount;
+    unsigned int pendingCount;
+    unsigned int isTruncated;           // Some task IDs were above the capacity
+    unsigned int ownerPid;
+};
+// One task in the segment (record i holds task ID i + 1)
+class SharedTaskRecord {
+public:
+    int id;                 // 0 while the record is unused
+    int state;              // VersionTaskState
+    int priority;
+    int deadline;
+    int duration;
+    char name[100];
+};
+// SHARED TASK VIEW CLASS (writer side, owned by one TaskManager)
+class SharedTaskView {
+private:
+    char segmentName[256];
+    SharedViewHeader* header;
+    SharedTaskRecord* records;
+    size_t mappedSize;
+    bool isWriting;             // Sequence counter is odd
+public:
+    // Constructor
+    SharedTaskView() {
+        segmentName[0] = '\0';
+        header = nullptr;
+        records = nullptr;
+        mappedSize = 0;
+        isWriting = false;
+    }
+    // Destructor, removes the segment if this process still owns it (readers keep
+    // their mapping until they unmap it)
+    ~SharedTaskView() {
+#ifdef __linux__
+        if (header) {
+            bool isOwner = header->ownerPid == (unsigned int)getpid();
+            munmap(header, mappedSize);
+            if (isOwner) {
+                shm_unlink(segmentName);
+            }
+        }
+#endif
+    }
+#ifdef __linux__
+    // True if segmentName is a view whose owner process has exited
+    bool isStaleSegment() {
+        int fd = shm_open(segmentName, O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat segmentStatus;
+        void* memory = MAP_FAILED;
+        if (fstat(fd, &segmentStatus) == 0 && (size_t)segmentStatus.st_size >= sizeof(SharedViewHeader)) {
+            memory = mmap(nullptr, sizeof(SharedViewHeader), PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED) {
+            return false;
+        }
+        SharedViewHeader* existing = (SharedViewHeader*)memory;
+        bool isStale = existing->magic == SHARED_VIEW_MAGIC && existing->ownerPid != 0 &&
+                       kill((pid_t)existing->ownerPid, 0) != 0 && errno == ESRCH;
+        munmap(memory, sizeof(SharedViewHeader));
+        return isStale;
+    }
+#endif
+    // Create the segment with room for capacity task records. Fails with EEXIST if
+    // the name is in use, unless it is left over from a process that has exited.
+    bool create(const char* name, int capacity) {
+#ifdef __linux__
+        if (capacity < 1 || strlen(name) == 0 || strlen(name) > 250) {
+            errno = EINVAL;
+            return false;
+        }
+        snprintf(segmentName, sizeof(segmentName), "%s%s", name[0] == '/' ? "" : "/", name);
+        mappedSize = sizeof(SharedViewHeader) + (size_t)capacity * sizeof(SharedTaskRecord);
+        int fd = shm_open(segmentName, O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0 && errno == EEXIST && isStaleSegment()) {
+            shm_unlink(segmentName);
+            fd = shm_open(segmentName, O_RDWR | O_CREAT | O_EXCL, 0644);
+        }
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, mappedSize) != 0) {
+            close(fd);
+            shm_unlink(segmentName);
+            return false;
+        }
+        void* memory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (memory == MAP_FAILED) {
+            shm_unlink(segmentName);
+            return false;
+        }
+        // A new segment is zero filled, which is a valid empty view
+        header = (SharedViewHeader*)memory;
+        records = (SharedTaskRecord*)(header + 1);
+        header->layoutVersion = SHARED_VIEW_LAYOUT;
+        header->capacity = capacity;
+        header->ownerPid = getpid();
+        header->sequence.store(0, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        header->magic = SHARED_VIEW_MAGIC;
+        return true;
+#else
+        (void)name;
+        (void)capacity;
+        return false;
+#endif
+    }
+    // Make the counter odd before the first write of an update
+    void beginUpdate() {
+        if (isWriting) {
+            return;
+        }
+        header->sequence.store(header->sequence.load(memory_order_relaxed) + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        isWriting = true;
+    }
+    // Write the record of a live task
+    void writeTask(Task* task, int state) {
+        beginUpdate();
+        if ((unsigned int)task->id > header->capacity) {
+            header->isTruncated = 1;
+            return;
+        }
+        SharedTaskRecord* record = &records[task->id - 1];
+        record->id = task->id;
+        record->state = state;
+        record->priority = task->priority;
+        record->deadline = task->deadline;
+        record->duration = task->duration;
+        memcpy(record->name, task->name, sizeof(record->name));
+        if ((unsigned int)task->id > header->highestId) {
+            header->highestId = task->id;
+        }
+    }
+    // Mark the record of a deleted task unused
+    void clearTask(int taskId) {
+        beginUpdate();
+        if (taskId >= 1 && (unsigned int)taskId <= header->capacity) {
+            records[taskId - 1].id = 0;
+        }
+    }
+    // Publish the counts and make the counter even again, readers now see the update
+    void finishUpdate(int allCount, int scheduledCount, int pendingCount) {
+        if (!isWriting) {
+            return;
+        }
+        header->allCount = allCount;
+        header->scheduledCount = scheduledCount;
+        header->pendingCount = pendingCount;
+        header->sequence.store(header->sequence.load(memory_order_relaxed) + 1, memory_order_release);
+        isWriting = false;
+    }
+};
+// ASYNC LOG SINK
+// Per-task scheduling messages are not written where they happen. The hot path
+// fills a structured record in a lock-free ring and returns; a background
+// thread formats the records and writes them in batches, one write per batch
+// instead of one per line. Producers never wait: a record is dropped (and
+// counted) when the ring is full or the per-second rate limit is reached.
+// Log levels, lower levels are filtered out by the sink's minimum level
+enum LogLevel {
+    LOG_DEBUG = 0,                  // Conflict details
+    LOG_INFO = 1,                   // Scheduling decisions
+    LOG_QUIET = 2                   // Only used as a minimum level, filters everything
+};
+// Message types, formatted by the writer thread
+enum LogEvent {
+    LOG_TASK_SCHEDULED = 1,         // name
+    LOG_TASK_PENDING = 2,           // name
+    LOG_CONFLICT_DETECTED = 3,      // depth, name (scheduled task), otherName (new task)
+    LOG_TASK_READMITTED = 4         // name
+};
+// LOG RECORD CLASS
+class LogRecord {
+public:
+    atomic<size_t> sequence;        // Ring position this cell is ready for (see LogRing)
+    int event;
+    int depth;
+    char name[100];
+    char otherName[100];
+};
+// LOG RING CLASS
+// Bounded multi-producer, single-consumer ring. Every cell carries a sequence
+// number: a cell whose sequence equals the enqueue position is free for that
+// position, and position + 1 means it holds a record for the consumer. A push is
+// one compare-and-swap on the enqueue position plus a copy into the claimed cell.
+class LogRing {
+private:
+    LogRecord* cells;
+    size_t mask;                        // Capacity - 1, capacity is a power of two
+    atomic<size_t> enqueuePosition;     // Shared by the producers
+    char padding[64];                   // Keep the consumer's position on its own cache line
+    size_t dequeuePosition;             // Consumer only
+public:
+    // Constructor
+    LogRing(int capacity) {
+        cells = new LogRecord[capacity];
+        mask = capacity - 1;
+        for (int i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+        enqueuePosition.store(0, memory_order_relaxed);
+        dequeuePosition = 0;
+        (void)padding;
+    }
+    // Destructor
+    ~LogRing() {
+        delete[] cells;
+    }
+    // Claim a cell for a new record, nullptr if the ring is full
+    LogRecord* beginPush() {
+        size_t position = enqueuePosition.load(memory_order_relaxed);
+        while (true) {
+            LogRecord* cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            long long difference = (long long)sequence - (long long)position;
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    return cell;
+                }
+            } else if (difference < 0) {
+                return nullptr;
+            } else {
+                position = enqueuePosition.load(memory_order_relaxed);
+            }
+        }
+    }
+    // Hand a filled cell to the consumer
+    void endPush(LogRecord* cell) {
+        cell->sequence.store(cell->sequence.load(memory_order_relaxed) + 1, memory_order_release);
+    }
+    // Oldest record, nullptr if none is ready (consumer only)
+    LogRecord* front() {
+        LogRecord* cell = &cells[dequeuePosition & mask];
+        if (cell->sequence.load(memory_order_acquire) != dequeuePosition + 1) {
+            return nullptr;
+        }
+        return cell;
+    }
+    // Release the record returned by front() for reuse (consumer only)
+    void pop(LogRecord* cell) {
+        cell->sequence.store(dequeuePosition + mask + 1, memory_order_release);
+        dequeuePosition++;
+    }
+    // Records claimed so far, and records consumed so far
+    size_t getEnqueuePosition() {
+        return enqueuePosition.load(memory_order_acquire);
+    }
+    size_t getDequeuePosition() {
+        return dequeuePosition;
+    }
+};
+// ASYNC LOG SINK CLASS
+class AsyncLogSink {
+private:
+    static const int RING_CAPACITY = 32768;
+    static const int WRITE_BUFFER_SIZE = 64 * 1024;
+    LogRing* ring;                          // Created with the writer thread on first use
+    thread writerThread;
+    atomic<bool> isStarted;
+    mutex startLock;
+    // Only used when the writer is idle or someone waits for it
+    mutex wakeLock;
+    condition_variable wakeSignal;
+    condition_variable drainedSignal;
+    bool isStopping;
+    bool isFlushRequested;
+    atomic<bool> isWriterIdle;              // Writer found the ring empty and is about to wait
+    atomic<size_t> writtenPosition;         // Records written (or filtered) by the writer
+    // Filtering and drop accounting
+    atomic<int> minimumLevel;
+    atomic<int> maxRecordsPerSecond;        // 0 = no limit
+    atomic<long long> rateWindow;           // Second the rate counter belongs to
+    atomic<int> rateWindowCount;
+    atomic<long long> droppedFull;
+    atomic<long long> droppedRateLimited;
+    long long reportedDropCount;            // Writer thread only
+    // Start the writer thread once
+    void start() {
+        lock_guard<mutex> guard(startLock);
+        if (isStarted.load(memory_order_relaxed)) {
+            return;
+        }
+        ring = new LogRing(RING_CAPACITY);
+        writerThread = thread(&AsyncLogSink::runWriter, this);
+        isStarted.store(true, memory_order_release);
+    }
+    // Format one record as a text line, returns its length
+    int formatRecord(LogRecord* record, char* output, int size) {
+        int length = 0;
+        switch (record->event) {
+            case LOG_TASK_SCHEDULED:
+                length = snprintf(output, size, "  ? Scheduled: %s\n", record->name);
+                break;
+            case LOG_TASK_PENDING:
+                length = snprintf(output, size, "  ? Pending (conflict): %s\n", record->name);
+                break;
+            case LOG_CONFLICT_DETECTED:
+                length = snprintf(output, size, "    Conflict detected at depth %d: Task '%s' conflicts with new task '%s'\n",
+                                  record->depth, record->name, record->otherName);
+                break;
+            case LOG_TASK_READMITTED:
+                length = snprintf(output, size, "  ? Re-admitted from pending: %s\n", record->name);
+                break;
+        }
+        return length < size ? length : size - 1;
+    }
+    // Writer thread: drain the ring into a buffer, write it, sleep when idle
+    void runWriter() {
+        char* buffer = new char[WRITE_BUFFER_SIZE];
+        int used = 0;
+        while (true) {
+            LogRecord* record;
+            while ((record = ring->front()) != nullptr) {
+                if (used + 512 > WRITE_BUFFER_SIZE) {
+                    fwrite(buffer, 1, used, stdout);
+                    used = 0;
+                }
+                used += formatRecord(record, buffer + used, WRITE_BUFFER_SIZE - used);
+                ring->pop(record);
+            }
+            if (used > 0) {
+                fwrite(buffer, 1, used, stdout);
+                fflush(stdout);
+                used = 0;
+            }
+            writtenPosition.store(ring->getDequeuePosition(), memory_order_release);
+            unique_lock<mutex> lock(wakeLock);
+            if (isFlushRequested) {
+                // Report new drops next to the output they belong to
+                long long dropCount = droppedFull.load() + droppedRateLimited.load();
+                if (dropCount > reportedDropCount) {
+                    printf("  [log] %lld messages dropped (ring full: %lld, rate limited: %lld)\n",
+                           dropCount - reportedDropCount, droppedFull.load(), droppedRateLimited.load());
+                    fflush(stdout);
+                    reportedDropCount = dropCount;
+                }
+                isFlushRequested = false;
+                drainedSignal.notify_all();
+            }
+            if (isStopping && !ring->front()) {
+                break;
+            }
+            // Announce the wait before the last look at the ring, so a record
+            // pushed after that look sees the flag and wakes the writer
+            isWriterIdle.store(true, memory_order_relaxed);
+            atomic_thread_fence(memory_order_seq_cst);
+            while (!ring->front() && !isStopping && !isFlushRequested) {
+                wakeSignal.wait(lock);
+            }
+            isWriterIdle.store(false, memory_order_relaxed);
+        }
+        delete[] buffer;
+    }
+public:
+    // Constructor
+    AsyncLogSink() {
+        ring = nullptr;
+        isStarted.store(false);
+        isStopping = false;
+        isFlushRequested = false;
+        isWriterIdle.store(false);
+        writtenPosition.store(0);
+        minimumLevel.store(LOG_DEBUG);
+        maxRecordsPerSecond.store(100000);
+        rateWindow.store(-1);
+        rateWindowCount.store(0);
+        droppedFull.store(0);
+        droppedRateLimited.store(0);
+        reportedDropCount = 0;
+    }
+    // Destructor, writes what is left and stops the writer
+    ~AsyncLogSink() {
+        if (!isStarted.load()) {
+            return;
+        }
+        flush();
+        {
+            lock_guard<mutex> guard(wakeLock);
+            isStopping = true;
+        }
+        wakeSignal.notify_one();
+        writerThread.join();
+        delete ring;
+    }
+    // Queue a record without blocking, safe to call from any thread
+    void log(int level, int event, int depth, const char* name, const char* otherName = nullptr) {
+        if (level < minimumLevel.load(memory_order_relaxed)) {
+            return;
+        }
+        int limit = maxRecordsPerSecond.load(memory_order_relaxed);
+        if (limit > 0) {
+            long long second = chrono::duration_cast<chrono::seconds>(
+                chrono::steady_clock::now().time_since_epoch()).count();
+            long long window = rateWindow.load(memory_order_relaxed);
+            if (window != second && rateWindow.compare_exchange_strong(window, second)) {
+                rateWindowCount.store(0, memory_order_relaxed);
+            }
+            if (rateWindowCount.fetch_add(1, memory_order_relaxed) >= limit) {
+                droppedRateLimited.fetch_add(1, memory_order_relaxed);
+                return;
+            }
+        }
+        if (!isStarted.load(memory_order_acquire)) {
+            start();
+        }
+        LogRecord* record = ring->beginPush();
+        if (!record) {
+            droppedFull.fetch_add(1, memory_order_relaxed);
+            return;
+        }
+        record->event = event;
+        record->depth = depth;
+        strncpy(record->name, name, 99);
+        record->name[99] = '\0';
+        strncpy(record->otherName, otherName ? otherName : "", 99);
+        record->otherName[99] = '\0';
+        ring->endPush(record);
+        // Only the push that ends an idle period takes the lock
+        atomic_thread_fence(memory_order_seq_cst);
+        if (isWriterIdle.load(memory_order_relaxed)) {
+            lock_guard<mutex> guard(wakeLock);
+            wakeSignal.notify_one();
+        }
+    }
+    // Wait until everything logged before this call is written (used before
+    // printing anything that must appear after the log lines)
+    void flush() {
+        if (!isStarted.load(memory_order_acquire)) {
+            return;
+        }
+        size_t target = ring->getEnqueuePosition();
+        unique_lock<mutex> lock(wakeLock);
+        do {
+            isFlushRequested = true;
+            wakeSignal.notify_one();
+            drainedSignal.wait_for(lock, chrono::milliseconds(5));
+        } while (writtenPosition.load(memory_order_acquire) < target || isFlushRequested);
+    }
+    // Settings
+    void setMinimumLevel(int level) {
+        minimumLevel.store(level);
+    }
+    void setRateLimit(int recordsPerSecond) {
+        maxRecordsPerSecond.store(recordsPerSecond);
+    }
+};
+// The process-wide log sink, created on first use
+AsyncLogSink& schedulerLog() {
+    static AsyncLogSink sink;
+    return sink;
+}
+// TASK HANDLE CLASS
+// Entry of the ID index: every node that currently represents one task, so a
+// delete can tombstone all of them in O(1) instead of searching each list
+class TaskHandle {
+public:
+    Task* task;             // Node in the all tasks list (nullptr once reclaimed)
+    Task* queueCopy;        // Copy in its priority queue
+    Task* scheduledCopy;    // Copy in the scheduled list, if scheduled
+    Task* pendingCopy;      // Copy in the pending list, if pending
+    bool isDeleted;         // Task was deleted, its ID is never reused
+};
 // TASK MANAGER CLASS - MAIN SYSTEM
+// Lists that can be exported
+enum TaskListType {
+    ALL_TASKS_LIST = 1,
+    SCHEDULED_TASKS_LIST = 2,
+    PENDING_TASKS_LIST = 3
+};
+// Result codes returned by TaskManager::scheduleTask
+enum ScheduleResult {
+    TASK_NOT_FOUND = -1,    // No task with the given ID
+    TASK_PENDING = 0,       // Conflict found, task added to pending list
+    TASK_SCHEDULED = 1      // Task added to scheduled list
+};
 class TaskManager {
 private:
     // Main linked lists
     Task* allTasksList;         // List of all tasks
+    Task* allTasksTail;         // Last node of the all tasks list (O(1) append)
     Task* scheduledTasksList;   // List of scheduled tasks
     Task* pendingTasksList;     // List of pending tasks
+    // List sizes, kept up to date so queries do not walk the lists
+    int allTaskCount;
+    int scheduledTaskCount;
+    int pendingTaskCount;
+    // Conflict window index, both allocated on first use (5 priorities x 31 deadline slots):
+    // how many scheduled tasks hold each slot, and the FIFO of pending tasks that were
+    // blocked in each slot and should be re-checked when a scheduled task leaves
+    int* scheduledSlotCounts;
+    Task** waiterHeads;
+    Task** waiterTails;
+    // ID index (array indexed by task ID, grown by doubling) and the number of
+    // tombstoned nodes still linked into the lists and queues
+    TaskHandle* taskHandles;
+    int handleCapacity;
+    int tombstoneCount;
+    // Persistent mirror of the task lists, kept up to date only while forks are
+    // outstanding, and a counter that changes with every live change so that a
+    // version forked from an older state cannot be committed
+    ScheduleVersion* liveVersion;
+    int outstandingForks;
+    long long liveGeneration;
+    bool isCommittingVersion;
+    // Shared memory view for external readers, nullptr unless enabled
+    SharedTaskView* sharedView;
     // History tracking
     HistoryNode* historyHead;   // Head of scheduling history
     // Data structures
     UndoStack undoSystem;               // Stack for undo operations
-    PriorityQueue* priorityQueues[5];   // Array of queues for each priority level
+    PriorityQueue* priorityQueues[5];   // Queues for each priority level, allocated on first use
     // Counter for generating unique task IDs
     int nextAvailableId;
+    // Print per-task scheduling messages (disabled in daemon mode)
+    bool verboseOutput;
     // Utility methods
     void clearInputBuffer();
     int getValidatedInteger(const string& prompt, int minValue, int maxValue);
     void getValidatedString(const string& prompt, char* buffer, int maxLength);
     // Linked list operations
     void addTaskToMainList(Task* newTask);
+    PriorityQueue* getPriorityQueue(int priority);
     Task* findTaskById(int taskId);
-    bool removeTaskFromList(int taskId);
+    void addToScheduledList(Task* task);
+    void addToPendingList(Task* task);
+    void unlinkFromPendingList(Task* task);
+    // ID index and tombstones
+    void reserveTaskHandles(int maxTaskId);
+    TaskHandle* getHandle(int taskId);
+    void tombstoneNode(Task* node);
+    Task* removeScheduledCopy(TaskHandle* handle);
+    void removePendingCopy(TaskHandle* handle);
+    void compactIfNeeded();
+    void compactTombstones();
+    // Change notifications for the live version and the shared view
+    int getTaskState(TaskHandle* handle);
+    void noteTaskChanged(int taskId);
+    void publishSharedView();
+    // Schedule versions
+    void syncLiveVersion(int taskId);
+    void applyVersionDiff(VersionNode* liveNode, VersionNode* versionNode, int level,
+                          Task** newlyScheduled, int& newlyScheduledCount);
+    void applyVersionTask(VersionTask* before, VersionTask* after,
+                          Task** newlyScheduled, int& newlyScheduledCount);
+    // Conflict window index
+    bool isWindowOccupied(int priority, int deadline);
+    int readmitPendingTasks(int priority, int deadline);
     // Sorting algorithm
     void sortTasksByPriorityAndDeadline(Task* &listHead);
     // Recursive functions
@@ -208,12 +1262,31 @@ private:
     // History management
     void addToSchedulingHistory(Task* scheduledTask);
     // Display functions
-    void displayTaskList(Task* listHead, const string& listName, bool showScheduledStatus = true);
+    void displayTaskList(Task* listHead, int liveCount, const string& listName, bool showScheduledStatus = true);
 public:
     // Constructor
     TaskManager();
     // Destructor
     ~TaskManager();
+    // Core operations (no console input, used by the menu and daemon mode)
+    int createTask(const char* name, int priority, int deadline, int duration);
+    bool updateTask(int taskId, const char* newName, int newPriority, int newDeadline, int newDuration);
+    bool deleteTask(int taskId, int* readmittedCount = nullptr);
+    int scheduleTask(int taskId);
+    bool scheduleAllTasks(int& scheduledCount, int& pendingCount);
+    int undoLastSchedule(bool& movedToPending, char* undoneName = nullptr, int* readmittedCount = nullptr);
+    bool getTaskDetails(int taskId, Task& details);
+    void getTaskCounts(int& allCount, int& scheduledCount, int& pendingCount);
+    void setVerboseOutput(bool enabled);
+    // Bulk import and export (CSV, or JSON Lines for .jsonl/.json files)
+    bool importTasks(const char* path, int& importedCount, int& rejectedCount);
+    bool exportTasks(const char* path, int listType, int& exportedCount);
+    // What-if scheduling: fork the current state, change the fork, commit it
+    ScheduleVersion* forkSchedule();
+    bool commitSchedule(ScheduleVersion* version);
+    void releaseFork(ScheduleVersion* version);
+    // Publish every task into a shared memory segment that other processes can map
+    bool enableSharedView(const char* name, int capacity);
     // Main operations
     void createNewTask();
     void updateExistingTask();
@@ -227,6 +1300,11 @@ public:
     void displayPendingTasks();
     void displaySchedulingHistory();
     void displayAllPriorityQueues();
+    // File operations
+    void importTasksFromFile();
+    void exportTasksToFile();
+    // What-if preview
+    void previewScheduleVariants();
     // Menu and program flow
     void displayMainMenu();
     void runScheduler();
@@ -235,21 +1313,37 @@ public:
 // Constructor
 TaskManager::TaskManager() {
     allTasksList = nullptr;
+    allTasksTail = nullptr;
     scheduledTasksList = nullptr;
     pendingTasksList = nullptr;
+    allTaskCount = 0;
+    scheduledTaskCount = 0;
+    pendingTaskCount = 0;
+    scheduledSlotCounts = nullptr;
+    waiterHeads = nullptr;
+    waiterTails = nullptr;
+    taskHandles = nullptr;
+    handleCapacity = 0;
+    tombstoneCount = 0;
+    liveVersion = nullptr;
+    outstandingForks = 0;
+    liveGeneration = 0;
+    isCommittingVersion = false;
+    sharedView = nullptr;
     historyHead = nullptr;
     nextAvailableId = 1;
-    // Initialize priority queues for levels 1-5
+    verboseOutput = true;
+    // Priority queues for levels 1-5 are created when the first task needs them,
+    // so an idle TaskManager costs only a few pointers
     for (int i = 0; i < 5; i++) {
-        priorityQueues[i] = new PriorityQueue(i + 1);
+        priorityQueues[i] = nullptr;
     }
-    cout << "=== SMART TASK SCHEDULER INITIALIZED ===" << endl;
-    cout << "Welcome to the Smart Task Scheduler!" << endl;
-    cout << "This system helps you manage and schedule tasks efficiently." << endl << endl;
 }
 // Destructor - Clean up all memory
 TaskManager::~TaskManager() {
-    cout << "Cleaning up memory..." << endl;
+    if (verboseOutput) {
+        cout << "Cleaning up memory..." << endl;
+    }
     // Delete all tasks from main lists
     while (allTasksList) {
         Task* temp = allTasksList;
@@ -266,6 +1360,12 @@ TaskManager::~TaskManager() {
         pendingTasksList = pendingTasksList->next;
         delete temp;
     }
+    delete[] scheduledSlotCounts;
+    delete[] waiterHeads;
+    delete[] waiterTails;
+    delete[] taskHandles;
+    delete liveVersion;
+    delete sharedView;
     // Delete history
     while (historyHead) {
         HistoryNode* temp = historyHead;
@@ -276,7 +1376,9 @@ TaskManager::~TaskManager() {
     for (int i = 0; i < 5; i++) {
         delete priorityQueues[i];
     } 
-    cout << "Memory cleanup complete. Goodbye!" << endl;
+    if (verboseOutput) {
+        cout << "Memory cleanup complete. Goodbye!" << endl;
+    }
 }
 // Clear the input buffer to prevent reading errors
 void TaskManager::clearInputBuffer() {
@@ -308,56 +1410,399 @@ void TaskManager::getValidatedString(const string& prompt, char* buffer, int max
         cin.getline(buffer, maxLength);
     }
 }
-// Add a task to the main linked list
+// Add a task to the main linked list and register it in the ID index
 void TaskManager::addTaskToMainList(Task* newTask) {
+    newTask->next = nullptr;
     if (!allTasksList) {
         allTasksList = newTask;
     } else {
-        Task* current = allTasksList;
-        while (current->next) {
-            current = current->next;
-        }
-        current->next = newTask;
+        allTasksTail->next = newTask;
     }
-    newTask->next = nullptr;
+    allTasksTail = newTask;
+    allTaskCount++;
+    reserveTaskHandles(newTask->id);
+    taskHandles[newTask->id].task = newTask;
+    noteTaskChanged(newTask->id);
+}
+// Get the queue for a priority level, creating it if needed
+PriorityQueue* TaskManager::getPriorityQueue(int priority) {
+    if (!priorityQueues[priority - 1]) {
+        priorityQueues[priority - 1] = new PriorityQueue(priority);
+    }
+    return priorityQueues[priority - 1];
 }
-// Find a task in the main list by its ID
+// Find a live task by its ID
 Task* TaskManager::findTaskById(int taskId) {
-    Task* current = allTasksList;   
+    TaskHandle* handle = getHandle(taskId);
+    return handle ? handle->task : nullptr;
+}
+// Make the ID index large enough for IDs up to maxTaskId
+void TaskManager::reserveTaskHandles(int maxTaskId) {
+    if (maxTaskId < handleCapacity) {
+        return;
+    }
+    int newCapacity = handleCapacity > 0 ? handleCapacity : 16;
+    while (newCapacity <= maxTaskId) {
+        newCapacity *= 2;
+    }
+    TaskHandle* newHandles = new TaskHandle[newCapacity]();
+    if (taskHandles) {
+        memcpy(newHandles, taskHandles, handleCapacity * sizeof(TaskHandle));
+        delete[] taskHandles;
+    }
+    taskHandles = newHandles;
+    handleCapacity = newCapacity;
+}
+// Get the index entry of a live task, nullptr for unknown or deleted IDs
+TaskHandle* TaskManager::getHandle(int taskId) {
+    if (taskId < 1 || taskId >= handleCapacity) {
+        return nullptr;
+    }
+    TaskHandle* handle = &taskHandles[taskId];
+    return (handle->task && !handle->isDeleted) ? handle : nullptr;
+}
+// Mark a node dead, it stays linked until the next compaction
+void TaskManager::tombstoneNode(Task* node) {
+    node->isTombstone = true;
+    tombstoneCount++;
+}
+// Add a task to the front of the scheduled list
+void TaskManager::addToScheduledList(Task* task) {
+    task->next = scheduledTasksList;
+    scheduledTasksList = task;
+    scheduledTaskCount++;
+    if (!scheduledSlotCounts) {
+        scheduledSlotCounts = new int[5 * 31]();
+    }
+    scheduledSlotCounts[conflictSlotIndex(task->priority, task->deadline)]++;
+    taskHandles[task->id].scheduledCopy = task;
+    noteTaskChanged(task->id);
+}
+// Add a task to the front of the pending list, indexing it by the window that blocked it
+void TaskManager::addToPendingList(Task* task) {
+    task->previous = nullptr;
+    task->next = pendingTasksList;
+    if (pendingTasksList) {
+        pendingTasksList->previous = task;
+    }
+    pendingTasksList = task;
+    pendingTaskCount++;
+    taskHandles[task->id].pendingCopy = task;
+    noteTaskChanged(task->id);
+    task->waitNext = nullptr;
+    if (!waiterHeads) {
+        waiterHeads = new Task*[5 * 31]();
+        waiterTails = new Task*[5 * 31]();
+    }
+    int slot = conflictSlotIndex(task->priority, task->deadline);
+    if (waiterTails[slot]) {
+        waiterTails[slot]->waitNext = task;
+    } else {
+        waiterHeads[slot] = task;
+    }
+    waiterTails[slot] = task;
+}
+// Unlink a node from the pending list (not from its waiter slot, not from the count)
+void TaskManager::unlinkFromPendingList(Task* task) {
+    if (task->previous) {
+        task->previous->next = task->next;
+    } else {
+        pendingTasksList = task->next;
+    }
+    if (task->next) {
+        task->next->previous = task->previous;
+    }
+}
+// Tombstone the scheduled copy of a task and release its conflict slot.
+// Returns the copy, which stays readable until the next compaction.
+Task* TaskManager::removeScheduledCopy(TaskHandle* handle) {
+    Task* scheduledCopy = handle->scheduledCopy;
+    handle->scheduledCopy = nullptr;
+    tombstoneNode(scheduledCopy);
+    scheduledTaskCount--;
+    scheduledSlotCounts[conflictSlotIndex(scheduledCopy->priority, scheduledCopy->deadline)]--;
+    noteTaskChanged(scheduledCopy->id);
+    return scheduledCopy;
+}
+// Tombstone the pending copy of a task (also dropping it as a waiter)
+void TaskManager::removePendingCopy(TaskHandle* handle) {
+    int taskId = handle->pendingCopy->id;
+    tombstoneNode(handle->pendingCopy);
+    handle->pendingCopy = nullptr;
+    pendingTaskCount--;
+    noteTaskChanged(taskId);
+}
+// Compact once tombstones outnumber live nodes, so every sweep is paid for
+// by at least as many earlier deletes (amortized O(1) per tombstone)
+void TaskManager::compactIfNeeded() {
+    const int MIN_TOMBSTONES_TO_COMPACT = 1024;
+    int liveNodeCount = 2 * allTaskCount + scheduledTaskCount + pendingTaskCount;
+    if (tombstoneCount >= MIN_TOMBSTONES_TO_COMPACT && tombstoneCount >= liveNodeCount) {
+        compactTombstones();
+    }
+}
+// Unlink and delete every tombstoned node in one pass over each structure
+void TaskManager::compactTombstones() {
+    // All tasks list: dead nodes are deleted tasks, their index entries are cleared
+    Task* previousTask = nullptr;
+    Task* current = allTasksList;
+    while (current) {
+        Task* nextTask = current->next;
+        if (current->isTombstone) {
+            if (previousTask) {
+                previousTask->next = nextTask;
+            } else {
+                allTasksList = nextTask;
+            }
+            taskHandles[current->id].task = nullptr;
+            delete current;
+        } else {
+            previousTask = current;
+        }
+        current = nextTask;
+    }
+    allTasksTail = previousTask;
+    // Scheduled list
+    previousTask = nullptr;
+    current = scheduledTasksList;
     while (current) {
-        if (current->id == taskId) {
-            return current;
+        Task* nextTask = current->next;
+        if (current->isTombstone) {
+            if (previousTask) {
+                previousTask->next = nextTask;
+            } else {
+                scheduledTasksList = nextTask;
+            }
+            delete current;
+        } else {
+            previousTask = current;
         }
-        current = current->next;
+        current = nextTask;
     }
-    
-    return nullptr;
+    // Waiter slots first, they only point into the pending list
+    if (waiterHeads) {
+        for (int slot = 0; slot < 5 * 31; slot++) {
+            Task* lastLive = nullptr;
+            Task* waiter = waiterHeads[slot];
+            waiterHeads[slot] = nullptr;
+            while (waiter) {
+                if (!waiter->isTombstone) {
+                    if (lastLive) {
+                        lastLive->waitNext = waiter;
+                    } else {
+                        waiterHeads[slot] = waiter;
+                    }
+                    lastLive = waiter;
+                }
+                waiter = waiter->waitNext;
+            }
+            if (lastLive) {
+                lastLive->waitNext = nullptr;
+            }
+            waiterTails[slot] = lastLive;
+        }
+    }
+    // Pending list
+    current = pendingTasksList;
+    while (current) {
+        Task* nextTask = current->next;
+        if (current->isTombstone) {
+            unlinkFromPendingList(current);
+            delete current;
+        }
+        current = nextTask;
+    }
+    // Priority queues
+    for (int i = 0; i < 5; i++) {
+        if (priorityQueues[i]) {
+            priorityQueues[i]->removeTombstones();
+        }
+    }
+    tombstoneCount = 0;
 }
-// Remove a task from the main list by its ID
-bool TaskManager::removeTaskFromList(int taskId) {
-    if (!allTasksList) {
+// Whether a live task is scheduled, pending or neither
+int TaskManager::getTaskState(TaskHandle* handle) {
+    if (handle->scheduledCopy) {
+        return TASK_STATE_SCHEDULED;
+    }
+    return handle->pendingCopy ? TASK_STATE_PENDING : TASK_STATE_UNSCHEDULED;
+}
+// A task was added, changed or deleted: update the live version and the shared view
+void TaskManager::noteTaskChanged(int taskId) {
+    syncLiveVersion(taskId);
+    if (!sharedView) {
+        return;
+    }
+    TaskHandle* handle = getHandle(taskId);
+    if (handle) {
+        sharedView->writeTask(handle->task, getTaskState(handle));
+    } else {
+        sharedView->clearTask(taskId);
+    }
+}
+// End of a public operation: let shared view readers see its changes
+void TaskManager::publishSharedView() {
+    if (sharedView) {
+        sharedView->finishUpdate(allTaskCount, scheduledTaskCount, pendingTaskCount);
+    }
+}
+// Mirror the current state of one task into the live version (no-op without forks)
+void TaskManager::syncLiveVersion(int taskId) {
+    if (!liveVersion || isCommittingVersion) {
+        return;
+    }
+    liveGeneration++;
+    TaskHandle* handle = getHandle(taskId);
+    if (!handle) {
+        liveVersion->removeTask(taskId);
+        return;
+    }
+    Task* task = handle->task;
+    VersionTask* record = new VersionTask();
+    record->id = task->id;
+    strcpy(record->name, task->name);
+    record->priority = task->priority;
+    record->deadline = task->deadline;
+    record->duration = task->duration;
+    record->state = getTaskState(handle);
+    if (handle->scheduledCopy) {
+        record->slotPriority = handle->scheduledCopy->priority;
+        record->slotDeadline = handle->scheduledCopy->deadline;
+    }
+    liveVersion->putTask(record);
+}
+// Walk the live trie and a committed version together. Subtrees the version still
+// shares with the live state are the same node and are skipped, so a commit costs
+// only what the version changed.
+void TaskManager::applyVersionDiff(VersionNode* liveNode, VersionNode* versionNode, int level,
+                                   Task** newlyScheduled, int& newlyScheduledCount) {
+    if (liveNode == versionNode) {
+        return;
+    }
+    for (int i = 0; i < 16; i++) {
+        if (level > 0) {
+            applyVersionDiff(liveNode ? liveNode->children[i] : nullptr,
+                             versionNode ? versionNode->children[i] : nullptr, level - 1,
+                             newlyScheduled, newlyScheduledCount);
+            continue;
+        }
+        VersionTask* before = liveNode ? liveNode->tasks[i] : nullptr;
+        VersionTask* after = versionNode ? versionNode->tasks[i] : nullptr;
+        if (before != after) {
+            applyVersionTask(before, after, newlyScheduled, newlyScheduledCount);
+        }
+    }
+}
+// Bring one live task in line with its record in a committed version. Tasks that
+// become scheduled are only collected, the caller schedules them in order.
+void TaskManager::applyVersionTask(VersionTask* before, VersionTask* after,
+                                   Task** newlyScheduled, int& newlyScheduledCount) {
+    // Versions never drop tasks, deletes always go through deleteTask
+    if (!after) {
+        return;
+    }
+    // Task added in the version
+    if (!before) {
+        Task* newTask = new Task();
+        newTask->id = after->id;
+        strcpy(newTask->name, after->name);
+        newTask->priority = after->priority;
+        newTask->deadline = after->deadline;
+        newTask->duration = after->duration;
+        addTaskToMainList(newTask);
+        taskHandles[newTask->id].queueCopy = getPriorityQueue(newTask->priority)->enqueueTask(newTask);
+    }
+    TaskHandle* handle = getHandle(after->id);
+    if (!handle) {
+        return;
+    }
+    Task* task = handle->task;
+    bool hasMoved = task->priority != after->priority || task->deadline != after->deadline;
+    strcpy(task->name, after->name);
+    task->duration = after->duration;
+    bool hasNewPriority = task->priority != after->priority;
+    task->priority = after->priority;
+    task->deadline = after->deadline;
+    // The queue copy moves to its new priority queue, or is refreshed in place
+    if (hasNewPriority && handle->queueCopy) {
+        tombstoneNode(handle->queueCopy);
+        getPriorityQueue(handle->queueCopy->priority)->noteTombstone();
+        handle->queueCopy = getPriorityQueue(task->priority)->enqueueTask(task);
+    } else if (handle->queueCopy) {
+        strcpy(handle->queueCopy->name, task->name);
+        handle->queueCopy->deadline = task->deadline;
+        handle->queueCopy->duration = task->duration;
+    }
+    // Copies made for the old priority/deadline hold the wrong slot, replace them
+    if (handle->scheduledCopy && (hasMoved || after->state != TASK_STATE_SCHEDULED)) {
+        removeScheduledCopy(handle);
+    }
+    if (handle->pendingCopy && (hasMoved || after->state != TASK_STATE_PENDING)) {
+        removePendingCopy(handle);
+    }
+    if (after->state == TASK_STATE_SCHEDULED && !handle->scheduledCopy) {
+        newlyScheduled[newlyScheduledCount++] = task;
+    } else if (after->state == TASK_STATE_PENDING && !handle->pendingCopy) {
+        addToPendingList(task->createCopy());
+    }
+    noteTaskChanged(task->id);
+}
+// Check whether a scheduled task holds the conflict window of (priority, deadline):
+// same priority and a deadline within 2 days
+bool TaskManager::isWindowOccupied(int priority, int deadline) {
+    if (!scheduledSlotCounts) {
         return false;
-    }  
-    // Check if task is at the beginning of the list
-    if (allTasksList->id == taskId) {
-        Task* temp = allTasksList;
-        allTasksList = allTasksList->next;
-        delete temp;
-        return true;
-    }   
-    // Search for the task in the list
-    Task* current = allTasksList;
-    while (current->next) {
-        if (current->next->id == taskId) {
-            Task* temp = current->next;
-            current->next = current->next->next;
-            delete temp;
+    }
+    for (int day = deadline - 2; day <= deadline + 2; day++) {
+        if (day >= 1 && day <= 30 && scheduledSlotCounts[conflictSlotIndex(priority, day)] > 0) {
             return true;
         }
-        current = current->next;
-    }  
+    }
     return false;
 }
+// A scheduled task at (priority, deadline) has left: re-check only the pending tasks
+// blocked in slots whose window contains it. All waiters in one slot share the same
+// window, so at most the oldest live waiter of each slot can be admitted.
+int TaskManager::readmitPendingTasks(int priority, int deadline) {
+    if (!waiterHeads) {
+        return 0;
+    }
+    int admittedCount = 0;
+    for (int day = deadline - 2; day <= deadline + 2; day++) {
+        if (day < 1 || day > 30) {
+            continue;
+        }
+        int slot = conflictSlotIndex(priority, day);
+        // Drop waiters that were deleted or scheduled some other way
+        while (waiterHeads[slot] && waiterHeads[slot]->isTombstone) {
+            waiterHeads[slot] = waiterHeads[slot]->waitNext;
+        }
+        Task* waiter = waiterHeads[slot];
+        if (!waiter) {
+            waiterTails[slot] = nullptr;
+            continue;
+        }
+        if (isWindowOccupied(priority, day)) {
+            continue;
+        }
+        waiterHeads[slot] = waiter->waitNext;
+        if (!waiterHeads[slot]) {
+            waiterTails[slot] = nullptr;
+        }
+        waiter->waitNext = nullptr;
+        unlinkFromPendingList(waiter);
+        pendingTaskCount--;
+        taskHandles[waiter->id].pendingCopy = nullptr;
+        addToScheduledList(waiter);
+        addToSchedulingHistory(waiter);
+        undoSystem.pushTask(waiter);
+        admittedCount++;
+        if (verboseOutput) {
+            schedulerLog().log(LOG_INFO, LOG_TASK_READMITTED, 0, waiter->name);
+        }
+    }
+    return admittedCount;
+}
 // Bubble sort algorithm to sort tasks by priority and deadline
 void TaskManager::sortTasksByPriorityAndDeadline(Task* &listHead) {
     if (!listHead || !listHead->next) {
@@ -415,15 +1860,20 @@ bool TaskManager::checkForSchedulingConflict(Task* scheduledTask, Task* newTask,
     if (!scheduledTask) {
         return false;
     }  
+    // Removed copies wait for compaction and never conflict
+    if (scheduledTask->isTombstone) {
+        return checkForSchedulingConflict(scheduledTask->next, newTask, depth);
+    }
     // Check if new task conflicts with this scheduled task
     // Simple conflict: same priority and deadlines within 2 days of each other
     bool hasConflict = (scheduledTask->priority == newTask->priority &&
                        abs(scheduledTask->deadline - newTask->deadline) <= 2);
     
     if (hasConflict) {
-        cout << "    Conflict detected at depth " << depth 
-             << ": Task '" << scheduledTask->name 
-             << "' conflicts with new task '" << newTask->name << "'" << endl;
+        if (verboseOutput) {
+            schedulerLog().log(LOG_DEBUG, LOG_CONFLICT_DETECTED, depth,
+                               scheduledTask->name, newTask->name);
+        }
         return true;
     }   
     // Recursively check the next task in the scheduled list
@@ -435,6 +1885,11 @@ void TaskManager::displayTasksRecursively(Task* currentTask, bool isScheduled, i
     if (!currentTask) {
         return;
     }   
+    // Skip dead nodes without using up a number
+    if (currentTask->isTombstone) {
+        displayTasksRecursively(currentTask->next, isScheduled, taskNumber);
+        return;
+    }
     // Display current task
     currentTask->displayTask(taskNumber, isScheduled);
     
@@ -448,41 +1903,373 @@ void TaskManager::addToSchedulingHistory(Task* scheduledTask) {
     historyHead = newHistoryNode;
 }
 // Display a task list with a descriptive name
-void TaskManager::displayTaskList(Task* listHead, const string& listName, bool showScheduledStatus) {
-    if (!listHead) {
+void TaskManager::displayTaskList(Task* listHead, int liveCount, const string& listName, bool showScheduledStatus) {
+    if (liveCount == 0) {
         cout << "\nNo tasks in " << listName << " list." << endl;
         return;
     }   
     cout << "\n=== " << listName << " ===" << endl;
     displayTasksRecursively(listHead, showScheduledStatus);
 }
-// Create a new task with user input
-void TaskManager::createNewTask() {
-    cout << "\n=== CREATE NEW TASK ===" << endl;
-    
+// Create a task from already validated values, returns the new ID (0 if invalid)
+int TaskManager::createTask(const char* name, int priority, int deadline, int duration) {
+    if (priority < 1 || priority > 5 || deadline < 1 || deadline > 30 ||
+        duration < 1 || duration > 24) {
+        return 0;
+    }
     Task* newTask = new Task();
     newTask->id = nextAvailableId++;
-    
-    getValidatedString("Enter task name: ", newTask->name, 100);
-    newTask->priority = getValidatedInteger("Enter priority (1=highest to 5=lowest): ", 1, 5);
-    newTask->deadline = getValidatedInteger("Enter deadline (days from now, 1-30): ", 1, 30);
-    newTask->duration = getValidatedInteger("Enter duration (hours required, 1-24): ", 1, 24);
+    strncpy(newTask->name, name, 99);
+    newTask->name[99] = '\0';
+    newTask->priority = priority;
+    newTask->deadline = deadline;
+    newTask->duration = duration;
     
     // Add to main list
     addTaskToMainList(newTask);
     
     // Add to appropriate priority queue
-    priorityQueues[newTask->priority - 1]->enqueueTask(newTask);
+    taskHandles[newTask->id].queueCopy = getPriorityQueue(newTask->priority)->enqueueTask(newTask);
+    publishSharedView();
+    return newTask->id;
+}
+// Update a task, empty name or out-of-range values keep the current value
+bool TaskManager::updateTask(int taskId, const char* newName, int newPriority, int newDeadline, int newDuration) {
+    Task* taskToUpdate = findTaskById(taskId);
+    if (!taskToUpdate) {
+        return false;
+    }
+    if (newName && strlen(newName) > 0) {
+        strncpy(taskToUpdate->name, newName, 99);
+        taskToUpdate->name[99] = '\0';
+    }
+    if (newPriority >= 1 && newPriority <= 5) {
+        taskToUpdate->priority = newPriority;
+    }
+    if (newDeadline >= 1 && newDeadline <= 30) {
+        taskToUpdate->deadline = newDeadline;
+    }
+    if (newDuration >= 1 && newDuration <= 24) {
+        taskToUpdate->duration = newDuration;
+    }
+    noteTaskChanged(taskId);
+    publishSharedView();
+    return true;
+}
+// Delete a task: tombstone every view of it through its ID handle in O(1).
+// The nodes are skipped by every list walk and reclaimed by a later compaction.
+bool TaskManager::deleteTask(int taskId, int* readmittedCount) {
+    TaskHandle* handle = getHandle(taskId);
+    if (!handle) {
+        return false;
+    }
+    handle->isDeleted = true;
+    tombstoneNode(handle->task);
+    allTaskCount--;
+    if (handle->queueCopy) {
+        tombstoneNode(handle->queueCopy);
+        getPriorityQueue(handle->queueCopy->priority)->noteTombstone();
+        handle->queueCopy = nullptr;
+    }
+    if (handle->pendingCopy) {
+        removePendingCopy(handle);
+    }
+    // A scheduled copy frees its window for the pending tasks it blocked
+    int admittedCount = 0;
+    if (handle->scheduledCopy) {
+        Task* scheduledCopy = removeScheduledCopy(handle);
+        admittedCount = readmitPendingTasks(scheduledCopy->priority, scheduledCopy->deadline);
+    }
+    if (readmittedCount) {
+        *readmittedCount = admittedCount;
+    }
+    noteTaskChanged(taskId);
+    publishSharedView();
+    compactIfNeeded();
+    return true;
+}
+// Schedule a single task, moving it to the pending list on conflict
+int TaskManager::scheduleTask(int taskId) {
+    TaskHandle* handle = getHandle(taskId);
+    if (!handle) {
+        return TASK_NOT_FOUND;
+    }
+    Task* taskToSchedule = handle->task;
+    // A task is scheduled at most once
+    if (handle->scheduledCopy) {
+        return TASK_SCHEDULED;
+    }
+    // Check for conflicts
+    if (isWindowOccupied(taskToSchedule->priority, taskToSchedule->deadline) &&
+        checkForSchedulingConflict(scheduledTasksList, taskToSchedule)) {
+        if (!handle->pendingCopy) {
+            addToPendingList(taskToSchedule->createCopy());
+            publishSharedView();
+        }
+        return TASK_PENDING;
+    }
+    if (handle->pendingCopy) {
+        removePendingCopy(handle);
+    }
+    addToScheduledList(taskToSchedule->createCopy());
+    // Add to history
+    addToSchedulingHistory(taskToSchedule);
+    // Push to undo stack
+    undoSystem.pushTask(taskToSchedule);
+    publishSharedView();
+    compactIfNeeded();
+    return TASK_SCHEDULED;
+}
+// Schedule every task that is not scheduled yet by priority and deadline,
+// returns false if there are no tasks
+bool TaskManager::scheduleAllTasks(int& scheduledCount, int& pendingCount) {
+    scheduledCount = 0;
+    pendingCount = 0;
+    if (allTaskCount == 0) {
+        return false;
+    }
+    // Create a temporary list for sorting
+    Task* sortedList = nullptr;
+    Task* current = allTasksList;
+    Task* lastNode = nullptr;
+    
+    // Copy all live, unscheduled tasks to temporary list
+    while (current) {
+        if (current->isTombstone || taskHandles[current->id].scheduledCopy) {
+            current = current->next;
+            continue;
+        }
+        Task* taskCopy = current->createCopy();
+        
+        if (!sortedList) {
+            sortedList = taskCopy;
+            lastNode = taskCopy;
+        } else {
+            lastNode->next = taskCopy;
+            lastNode = taskCopy;
+        }
+        current = current->next;
+    }
+    // Sort the temporary list
+    sortTasksByPriorityAndDeadline(sortedList);
+    // Schedule tasks from sorted list
+    current = sortedList;
+    while (current) {
+        TaskHandle* handle = &taskHandles[current->id];
+        // Check for conflicts with already scheduled tasks (the window index
+        // skips the list walk when no scheduled task is near this one)
+        if (!isWindowOccupied(current->priority, current->deadline) ||
+            !checkForSchedulingConflict(scheduledTasksList, current)) {
+            // No conflict - schedule the task
+            if (handle->pendingCopy) {
+                removePendingCopy(handle);
+            }
+            addToScheduledList(current->createCopy());
+            // Add to history
+            addToSchedulingHistory(current);        
+            // Push to undo stack
+            undoSystem.pushTask(current);         
+            scheduledCount++;
+            if (verboseOutput) {
+                schedulerLog().log(LOG_INFO, LOG_TASK_SCHEDULED, 0, current->name);
+            }
+        } else {
+            // Conflict found - add to pending list
+            if (!handle->pendingCopy) {
+                addToPendingList(current->createCopy());
+            }
+            pendingCount++;
+            if (verboseOutput) {
+                schedulerLog().log(LOG_INFO, LOG_TASK_PENDING, 0, current->name);
+            }
+        } 
+        current = current->next;
+    }
+    // Clean up temporary list
+    while (sortedList) {
+        Task* temp = sortedList;
+        sortedList = sortedList->next;
+        delete temp;
+    }
+    publishSharedView();
+    compactIfNeeded();
+    return true;
+}
+// Undo the last scheduled task that still exists, returns its ID (0 if there is nothing to undo)
+int TaskManager::undoLastSchedule(bool& movedToPending, char* undoneName, int* readmittedCount) {
+    movedToPending = false;
+    Task* lastScheduledTask = undoSystem.popTask();
+    // Entries of deleted tasks are dropped
+    while (lastScheduledTask && !getHandle(lastScheduledTask->id)) {
+        delete lastScheduledTask;
+        lastScheduledTask = undoSystem.popTask();
+    }
+    if (!lastScheduledTask) {
+        return 0;
+    }
+    int undoneId = lastScheduledTask->id;
+    if (undoneName) {
+        strcpy(undoneName, lastScheduledTask->name);
+    }
+    int admittedCount = 0;
+    TaskHandle* handle = getHandle(undoneId);
+    if (handle->scheduledCopy) {
+        // Let the tasks it blocked in first, then park it in the pending list. It
+        // waits like any other pending task and is re-admitted once its window frees.
+        Task* scheduledCopy = removeScheduledCopy(handle);
+        admittedCount = readmitPendingTasks(scheduledCopy->priority, scheduledCopy->deadline);
+        addToPendingList(lastScheduledTask->createCopy());
+        movedToPending = true;
+    }
+    if (readmittedCount) {
+        *readmittedCount = admittedCount;
+    }
+    delete lastScheduledTask;
+    publishSharedView();
+    compactIfNeeded();
+    return undoneId;
+}
+// Copy the details of a task into the given object
+bool TaskManager::getTaskDetails(int taskId, Task& details) {
+    Task* task = findTaskById(taskId);
+    if (!task) {
+        return false;
+    }
+    details.id = task->id;
+    strcpy(details.name, task->name);
+    details.priority = task->priority;
+    details.deadline = task->deadline;
+    details.duration = task->duration;
+    return true;
+}
+// Get the number of tasks in each list
+void TaskManager::getTaskCounts(int& allCount, int& scheduledCount, int& pendingCount) {
+    allCount = allTaskCount;
+    scheduledCount = scheduledTaskCount;
+    pendingCount = pendingTaskCount;
+}
+// Enable or disable console messages for individual tasks
+void TaskManager::setVerboseOutput(bool enabled) {
+    verboseOutput = enabled;
+}
+// Fork the current state. Forks are O(1) while another fork is outstanding;
+// the first fork after all of them are released rebuilds the live version
+// from every task in O(n), and changes keep it up to date until the last
+// fork is handed back with releaseFork.
+ScheduleVersion* TaskManager::forkSchedule() {
+    if (!liveVersion) {
+        liveVersion = new ScheduleVersion();
+        for (Task* current = allTasksList; current; current = current->next) {
+            if (!current->isTombstone) {
+                syncLiveVersion(current->id);
+            }
+        }
+    }
+    liveVersion->setNextTaskId(nextAvailableId);
+    ScheduleVersion* version = liveVersion->fork();
+    version->setBaseGeneration(liveGeneration);
+    outstandingForks++;
+    return version;
+}
+// Delete a fork returned by forkSchedule. The live version goes with the last
+// one, so changes stop paying for its upkeep; forks of the fork stay valid but
+// can no longer be committed.
+void TaskManager::releaseFork(ScheduleVersion* version) {
+    delete version;
+    outstandingForks--;
+    if (outstandingForks == 0) {
+        delete liveVersion;
+        liveVersion = nullptr;
+        liveGeneration++;
+    }
+}
+// Make a forked version the current state. Fails (changing nothing) if the tasks
+// changed after the fork; otherwise every difference is applied in one step.
+bool TaskManager::commitSchedule(ScheduleVersion* version) {
+    if (!liveVersion || version->getBaseGeneration() != liveGeneration) {
+        return false;
+    }
+    // Line up the trie heights, then apply only the subtrees that differ
+    liveVersion->reserveLevels(version->getNextTaskId() - 1);
+    version->reserveLevels(liveVersion->getNextTaskId() - 1);
+    if (version->getNextTaskId() > nextAvailableId) {
+        nextAvailableId = version->getNextTaskId();
+    }
+    isCommittingVersion = true;
+    Task** newlyScheduled = new Task*[version->getScheduledCount() + 1];
+    int newlyScheduledCount = 0;
+    applyVersionDiff(liveVersion->getRoot(), version->getRoot(), liveVersion->getLevelCount() - 1,
+                     newlyScheduled, newlyScheduledCount);
+    // Schedule them by priority, deadline and ID like scheduleAllTasks does, so the
+    // history and the undo stack look the same as after a direct scheduling run
+    int slotStarts[5 * 31 + 1];
+    for (int i = 0; i <= 5 * 31; i++) {
+        slotStarts[i] = 0;
+    }
+    for (int i = 0; i < newlyScheduledCount; i++) {
+        slotStarts[conflictSlotIndex(newlyScheduled[i]->priority, newlyScheduled[i]->deadline) + 1]++;
+    }
+    for (int i = 1; i <= 5 * 31; i++) {
+        slotStarts[i] += slotStarts[i - 1];
+    }
+    Task** sortedTasks = new Task*[newlyScheduledCount + 1];
+    for (int i = 0; i < newlyScheduledCount; i++) {
+        sortedTasks[slotStarts[conflictSlotIndex(newlyScheduled[i]->priority, newlyScheduled[i]->deadline)]++] = newlyScheduled[i];
+    }
+    for (int i = 0; i < newlyScheduledCount; i++) {
+        addToScheduledList(sortedTasks[i]->createCopy());
+        addToSchedulingHistory(sortedTasks[i]);
+        undoSystem.pushTask(sortedTasks[i]);
+    }
+    delete[] sortedTasks;
+    delete[] newlyScheduled;
+    isCommittingVersion = false;
+    // The live state now matches the version, so it can share its trie
+    liveVersion->adopt(version);
+    liveGeneration++;
+    publishSharedView();
+    compactIfNeeded();
+    return true;
+}
+// Create the shared memory view and publish every live task into it
+bool TaskManager::enableSharedView(const char* name, int capacity) {
+    SharedTaskView* view = new SharedTaskView();
+    if (!view->create(name, capacity)) {
+        delete view;
+        return false;
+    }
+    delete sharedView;
+    sharedView = view;
+    for (Task* current = allTasksList; current; current = current->next) {
+        if (!current->isTombstone) {
+            sharedView->writeTask(current, getTaskState(&taskHandles[current->id]));
+        }
+    }
+    sharedView->beginUpdate();
+    publishSharedView();
+    return true;
+}
+// Create a new task with user input
+void TaskManager::createNewTask() {
+    cout << "\n=== CREATE NEW TASK ===" << endl;
+    
+    char name[100];
+    getValidatedString("Enter task name: ", name, 100);
+    int priority = getValidatedInteger("Enter priority (1=highest to 5=lowest): ", 1, 5);
+    int deadline = getValidatedInteger("Enter deadline (days from now, 1-30): ", 1, 30);
+    int duration = getValidatedInteger("Enter duration (hours required, 1-24): ", 1, 24);
+    
+    int taskId = createTask(name, priority, deadline, duration);
     
     cout << "\nTask created successfully!" << endl;
-    cout << "Task ID: " << newTask->id << endl;
-    cout << "Task Name: " << newTask->name << endl;
-    cout << "Added to Priority Queue: " << newTask->priority << endl;
+    cout << "Task ID: " << taskId << endl;
+    cout << "Task Name: " << name << endl;
+    cout << "Added to Priority Queue: " << priority << endl;
 }
 
 // Update an existing task
 void TaskManager::updateExistingTask() {
-    if (!allTasksList) {
+    if (allTaskCount == 0) {
         cout << "\nNo tasks available to update." << endl;
         return;
     }
@@ -511,27 +2298,23 @@ void TaskManager::updateExistingTask() {
     char newName[100];
     cout << "New name [" << taskToUpdate->name << "]: ";
     cin.getline(newName, 100);
-    if (strlen(newName) > 0) {
-        strcpy(taskToUpdate->name, newName);
-    }
     
     // Update priority
     char priorityInput[10];
     cout << "New priority (1-5) [" << taskToUpdate->priority << "]: ";
     cin.getline(priorityInput, 10);
+    int newPriority = 0;
     if (strlen(priorityInput) > 0) {
-        int newPriority = atoi(priorityInput);
-        if (newPriority >= 1 && newPriority <= 5) {
-            taskToUpdate->priority = newPriority;
-        }
+        newPriority = atoi(priorityInput);
     }    
     // Similar updates for deadline and duration would go here...
+    updateTask(taskId, newName, newPriority, 0, 0);
     
     cout << "\nTask updated successfully!" << endl;
 }
 // Delete an existing task
 void TaskManager::deleteExistingTask() {
-    if (!allTasksList) {
+    if (allTaskCount == 0) {
         cout << "\nNo tasks available to delete." << endl;
         return;
     } 
@@ -542,83 +2325,40 @@ void TaskManager::deleteExistingTask() {
     
     int taskId = getValidatedInteger("\nEnter task ID to delete: ", 1, nextAvailableId - 1);
     
-    if (removeTaskFromList(taskId)) {
+    int readmittedCount = 0;
+    bool isDeleted = deleteTask(taskId, &readmittedCount);
+    schedulerLog().flush();
+    if (isDeleted) {
         cout << "\nTask with ID " << taskId << " deleted successfully!" << endl;
+        if (readmittedCount > 0) {
+            cout << "Pending tasks re-admitted: " << readmittedCount << endl;
+        }
     } else {
         cout << "\nError: Task with ID " << taskId << " not found!" << endl;
     }
 }
 // Schedule tasks automatically based on priority and deadline
 void TaskManager::scheduleTasksAutomatically() {
-    if (!allTasksList) {
+    if (allTaskCount == 0) {
         cout << "\nNo tasks available to schedule." << endl;
         return;
     }
     cout << "\n=== AUTOMATIC SCHEDULING ===" << endl;
     cout << "Scheduling tasks by priority and deadline..." << endl;
+    cout << "\nScheduling results:" << endl;
     
-    // Create a temporary list for sorting
-    Task* sortedList = nullptr;
-    Task* current = allTasksList;
-    Task* lastNode = nullptr;
+    int scheduledCount = 0;
+    int pendingCount = 0;
+    scheduleAllTasks(scheduledCount, pendingCount);
+    schedulerLog().flush();
     
-    // Copy all tasks to temporary list
-    while (current) {
-        Task* taskCopy = current->createCopy();
-        
-        if (!sortedList) {
-            sortedList = taskCopy;
-            lastNode = taskCopy;
-        } else {
-            lastNode->next = taskCopy;
-            lastNode = taskCopy;
-        }
-        current = current->next;
-    }
-    // Sort the temporary list
-    sortTasksByPriorityAndDeadline(sortedList);
-    // Schedule tasks from sorted list
-    current = sortedList;
-    int scheduledCount = 0;
-    int pendingCount = 0;
-    cout << "\nScheduling results:" << endl;
-    while (current) {
-        // Check for conflicts with already scheduled tasks
-        if (!checkForSchedulingConflict(scheduledTasksList, current)) {
-            // No conflict - schedule the task
-            Task* scheduledTask = current->createCopy();
-            scheduledTask->next = scheduledTasksList;
-            scheduledTasksList = scheduledTask;         
-           // Add to history
-            addToSchedulingHistory(current);        
-            // Push to undo stack
-            undoSystem.pushTask(current);         
-            scheduledCount++;
-            cout << "  ? Scheduled: " << current->name << endl;
-        } else {
-            // Conflict found - add to pending list
-            Task* pendingTask = current->createCopy();
-            pendingTask->next = pendingTasksList;
-            pendingTasksList = pendingTask;
-            
-            pendingCount++;
-            cout << "  ? Pending (conflict): " << current->name << endl;
-        } 
-        current = current->next;
-    }
-    // Clean up temporary list
-    while (sortedList) {
-        Task* temp = sortedList;
-        sortedList = sortedList->next;
-        delete temp;
-    }
     cout << "\nScheduling complete!" << endl;
     cout << "Tasks scheduled: " << scheduledCount << endl;
     cout << "Tasks pending due to conflicts: " << pendingCount << endl;
 }
 // Schedule a specific task manually
 void TaskManager::scheduleTaskManually() {
-    if (!allTasksList) {
+    if (allTaskCount == 0) {
         cout << "\nNo tasks available to schedule." << endl;
         return;
     }
@@ -632,25 +2372,12 @@ void TaskManager::scheduleTaskManually() {
         return;
     }    
     cout << "\nAttempting to schedule task: " << taskToSchedule->name << endl;    
-    // Check for conflicts
-    if (checkForSchedulingConflict(scheduledTasksList, taskToSchedule)) {
+    int result = scheduleTask(taskId);
+    schedulerLog().flush();
+    if (result == TASK_PENDING) {
         cout << "Cannot schedule task due to conflicts." << endl;
         cout << "Task moved to pending list." << endl;       
-        // Add to pending list
-        Task* pendingTask = taskToSchedule->createCopy();
-        pendingTask->next = pendingTasksList;
-        pendingTasksList = pendingTask;
     } else {
-        // Schedule the task
-        Task* scheduledTask = taskToSchedule->createCopy();
-        scheduledTask->next = scheduledTasksList;
-        scheduledTasksList = scheduledTask;
-        
-        // Add to history
-        addToSchedulingHistory(taskToSchedule);
-        
-        // Push to undo stack
-        undoSystem.pushTask(taskToSchedule);        
         cout << "Task scheduled successfully!" << endl;
     }
 }
@@ -661,58 +2388,37 @@ void TaskManager::undoScheduledTask() {
         return;
     }   
     cout << "\n=== UNDO LAST SCHEDULED TASK ===" << endl;   
-    Task* lastScheduledTask = undoSystem.popTask();
-    if (!lastScheduledTask) {
-        cout << "Error: Undo operation failed!" << endl;
+    bool movedToPending = false;
+    char undoneName[100];
+    int readmittedCount = 0;
+    int undoneId = undoLastSchedule(movedToPending, undoneName, &readmittedCount);
+    schedulerLog().flush();
+    if (!undoneId) {
+        cout << "Nothing to undo, all scheduled tasks were deleted." << endl;
         return;
     }    
-    cout << "Undoing task: " << lastScheduledTask->name << endl; 
-    // Remove from scheduled list
-    bool wasRemoved = false;    
-    // Check if task is at the beginning of scheduled list
-    if (scheduledTasksList && scheduledTasksList->id == lastScheduledTask->id) {
-        Task* temp = scheduledTasksList;
-        scheduledTasksList = scheduledTasksList->next;
-        delete temp;
-        wasRemoved = true;
-    } else {
-        // Search for task in scheduled list
-        Task* current = scheduledTasksList;
-        while (current && current->next) {
-            if (current->next->id == lastScheduledTask->id) {
-                Task* temp = current->next;
-                current->next = current->next->next;
-                delete temp;
-                wasRemoved = true;
-                break;
-            }
-            current = current->next;
-        }
-    }    
-    if (wasRemoved) {
-        // Move to pending list
-        Task* pendingTask = lastScheduledTask->createCopy();
-        pendingTask->next = pendingTasksList;
-        pendingTasksList = pendingTask;
-        
+    cout << "Undoing task: " << undoneName << endl; 
+    if (movedToPending) {
         cout << "Task moved to pending list." << endl;
+        if (readmittedCount > 0) {
+            cout << "Pending tasks re-admitted: " << readmittedCount << endl;
+        }
     } else {
         cout << "Task not found in scheduled list." << endl;
     }    
-    delete lastScheduledTask;
     cout << "Undo operation completed." << endl;
 }
 // Display all tasks
 void TaskManager::displayAllTasks() {
-    displayTaskList(allTasksList, "ALL TASKS", false);
+    displayTaskList(allTasksList, allTaskCount, "ALL TASKS", false);
 }
 // Display scheduled tasks
 void TaskManager::displayScheduledTasks() {
-    displayTaskList(scheduledTasksList, "SCHEDULED TASKS", true);
+    displayTaskList(scheduledTasksList, scheduledTaskCount, "SCHEDULED TASKS", true);
 }
 // Display pending tasks
 void TaskManager::displayPendingTasks() {
-    displayTaskList(pendingTasksList, "PENDING TASKS", false);
+    displayTaskList(pendingTasksList, pendingTaskCount, "PENDING TASKS", false);
 }
 // Display scheduling history
 void TaskManager::displaySchedulingHistory() {
@@ -740,6 +2446,9 @@ void TaskManager::displayAllPriorityQueues() {
     bool anyQueueHasTasks = false;
     
     for (int i = 0; i < 5; i++) {
+        if (!priorityQueues[i]) {
+            continue;
+        }
         int taskCount = priorityQueues[i]->getTaskCount();
         
         if (taskCount > 0) {
@@ -752,6 +2461,114 @@ void TaskManager::displayAllPriorityQueues() {
         cout << "\nAll priority queues are empty." << endl;
     }
 }
+// Import tasks from a CSV or JSON Lines file
+void TaskManager::importTasksFromFile() {
+    cout << "\n=== IMPORT TASKS ===" << endl;
+    char path[256];
+    getValidatedString("Enter file path (.csv or .jsonl): ", path, 256);
+    int importedCount, rejectedCount;
+    if (!importTasks(path, importedCount, rejectedCount)) {
+        cout << "Error: Could not read file " << path << endl;
+        return;
+    }
+    cout << "\nImport complete!" << endl;
+    cout << "Tasks imported: " << importedCount << endl;
+    cout << "Lines rejected: " << rejectedCount << endl;
+}
+// Export a task list to a CSV or JSON Lines file
+void TaskManager::exportTasksToFile() {
+    cout << "\n=== EXPORT TASKS ===" << endl;
+    cout << "1. All Tasks" << endl;
+    cout << "2. Scheduled Tasks" << endl;
+    cout << "3. Pending Tasks" << endl;
+    int listType = getValidatedInteger("Select list to export (1-3): ", 1, 3);
+    char path[256];
+    getValidatedString("Enter file path (.csv or .jsonl): ", path, 256);
+    int exportedCount;
+    if (!exportTasks(path, listType, exportedCount)) {
+        cout << "Error: Could not write file " << path << endl;
+        return;
+    }
+    cout << "\nExport complete! Tasks written: " << exportedCount << endl;
+}
+// Build what-if schedules on forks of the current state and commit the best one
+void TaskManager::previewScheduleVariants() {
+    if (allTaskCount == 0) {
+        cout << "\nNo tasks available to preview." << endl;
+        return;
+    }
+    cout << "\n=== WHAT-IF SCHEDULING ===" << endl;
+    const int MAX_VARIANTS = 9;
+    ScheduleVersion* variants[MAX_VARIANTS];
+    int variantCount = 0;
+    ScheduleVersion* currentState = forkSchedule();
+    // Variant 1 is the current tasks scheduled as they are
+    int scheduledNow = 0;
+    int pendingNow = 0;
+    variants[variantCount] = currentState->fork();
+    variants[variantCount]->scheduleAllTasks(scheduledNow, pendingNow);
+    variantCount++;
+    cout << "Variant 1 (current tasks): Scheduled: " << variants[0]->getScheduledCount()
+         << " | Pending: " << variants[0]->getPendingCount() << endl;
+    int choice;
+    do {
+        cout << "\n1. New variant: change a task's priority/deadline" << endl;
+        cout << "2. New variant: add a task" << endl;
+        cout << "3. Display a variant" << endl;
+        cout << "4. Commit a variant" << endl;
+        cout << "5. Return without committing" << endl;
+        choice = getValidatedInteger("Enter your choice (1-5): ", 1, 5);
+        if ((choice == 1 || choice == 2) && variantCount == MAX_VARIANTS) {
+            cout << "Variant limit reached (" << MAX_VARIANTS << "), commit or discard first." << endl;
+            continue;
+        }
+        if (choice == 1 || choice == 2) {
+            int baseNumber = getValidatedInteger("Base it on variant (0 = current tasks): ", 0, variantCount);
+            ScheduleVersion* variant = (baseNumber == 0 ? currentState : variants[baseNumber - 1])->fork();
+            if (choice == 1) {
+                int taskId = getValidatedInteger("Enter task ID: ", 1, variant->getNextTaskId() - 1);
+                if (!variant->findTask(taskId)) {
+                    cout << "Error: Task with ID " << taskId << " not found!" << endl;
+                    delete variant;
+                    continue;
+                }
+                int newPriority = getValidatedInteger("New priority (1-5): ", 1, 5);
+                int newDeadline = getValidatedInteger("New deadline (1-30): ", 1, 30);
+                variant->updateTask(taskId, newPriority, newDeadline);
+            } else {
+                char name[100];
+                getValidatedString("Enter task name: ", name, 100);
+                int priority = getValidatedInteger("Enter priority (1=highest to 5=lowest): ", 1, 5);
+                int deadline = getValidatedInteger("Enter deadline (days from now, 1-30): ", 1, 30);
+                int duration = getValidatedInteger("Enter duration (hours required, 1-24): ", 1, 24);
+                variant->addTask(name, priority, deadline, duration);
+            }
+            variant->scheduleAllTasks(scheduledNow, pendingNow);
+            variants[variantCount++] = variant;
+            cout << "Variant " << variantCount << ": Tasks: " << variant->getTaskCount()
+                 << " | Scheduled: " << variant->getScheduledCount()
+                 << " | Pending: " << variant->getPendingCount() << endl;
+        } else if (choice == 3) {
+            int number = getValidatedInteger("Variant to display: ", 1, variantCount);
+            variants[number - 1]->displayTasks(TASK_STATE_SCHEDULED, "SCHEDULED TASKS");
+            variants[number - 1]->displayTasks(TASK_STATE_PENDING, "PENDING TASKS");
+        } else if (choice == 4) {
+            int number = getValidatedInteger("Variant to commit: ", 1, variantCount);
+            if (commitSchedule(variants[number - 1])) {
+                cout << "\nVariant " << number << " committed!" << endl;
+                cout << "Tasks scheduled: " << scheduledTaskCount << endl;
+                cout << "Tasks pending due to conflicts: " << pendingTaskCount << endl;
+            } else {
+                cout << "\nError: Tasks changed since the preview, nothing was committed." << endl;
+            }
+            choice = 5;
+        }
+    } while (choice != 5);
+    for (int i = 0; i < variantCount; i++) {
+        delete variants[i];
+    }
+    releaseFork(currentState);
+}
 // Display the main menu
 void TaskManager::displayMainMenu() {
     cout << "\n=========================================" << endl;
@@ -768,15 +2585,21 @@ void TaskManager::displayMainMenu() {
     cout << "9.  Undo Last Scheduled Task" << endl;
     cout << "10. Display Scheduling History" << endl;
     cout << "11. Display Priority Queues" << endl;
-    cout << "12. Exit Program" << endl;
+    cout << "12. Import Tasks from File" << endl;
+    cout << "13. Export Tasks to File" << endl;
+    cout << "14. What-If Scheduling Preview" << endl;
+    cout << "15. Exit Program" << endl;
     cout << "=========================================" << endl;
 }
 // Main program loop
 void TaskManager::runScheduler() {
+    cout << "=== SMART TASK SCHEDULER INITIALIZED ===" << endl;
+    cout << "Welcome to the Smart Task Scheduler!" << endl;
+    cout << "This system helps you manage and schedule tasks efficiently." << endl << endl;
     int userChoice;
     do {
         displayMainMenu();
-        userChoice = getValidatedInteger("Enter your choice (1-12): ", 1, 12);
+        userChoice = getValidatedInteger("Enter your choice (1-15): ", 1, 15);
         switch (userChoice) {
             case 1:
                 createNewTask();
@@ -812,20 +2635,2327 @@ void TaskManager::runScheduler() {
                 displayAllPriorityQueues();
                 break;
             case 12:
+                importTasksFromFile();
+                break;
+            case 13:
+                exportTasksToFile();
+                break;
+            case 14:
+                previewScheduleVariants();
+                break;
+            case 15:
                 cout << "\nThank you for using the Smart Task Scheduler!" << endl;
                 break;
             default:
                 cout << "Invalid choice! Please try again." << endl;
         }
         // Pause to let user read output
-        if (userChoice != 12) {
+        if (userChoice != 15) {
             cout << "\nPress Enter to continue...";
             clearInputBuffer();
         }
-    } while (userChoice != 12);
+    } while (userChoice != 15);
 }
-// MAIN FUNCTION
-int main() {
+// BULK IMPORT AND EXPORT
+// Import maps the whole file, splits it into newline-aligned chunks and parses
+// them on separate threads. Each thread builds its own chain of tasks and of
+// priority queue copies, so the merge is a handful of pointer splices and one
+// ID range allocation instead of a list walk per task.
+// CSV lines are [id,]name,priority,deadline,duration (an optional header line is
+// skipped, names may be quoted). JSON Lines objects need "name", "priority",
+// "deadline" and "duration". Imported tasks always get new IDs.
+// READ-ONLY FILE MAPPING CLASS
+class MappedFile {
+private:
+    char* data;             // File contents
+    long long size;         // Size in bytes
+    bool isMapped;          // data comes from mmap (otherwise from new[])
+public:
+    // Constructor
+    MappedFile() {
+        data = nullptr;
+        size = 0;
+        isMapped = false;
+    }
+    // Destructor
+    ~MappedFile() {
+#ifdef __linux__
+        if (isMapped) {
+            munmap(data, size);
+            return;
+        }
+#endif
+        delete[] data;
+    }
+    // Map (or read) a file, false if it cannot be opened
+    bool openFile(const char* path) {
+#ifdef __linux__
+        int fileFd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fileFd < 0) {
+            return false;
+        }
+        struct stat fileInfo;
+        if (fstat(fileFd, &fileInfo) < 0) {
+            close(fileFd);
+            return false;
+        }
+        size = fileInfo.st_size;
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileFd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fileFd);
+                return false;
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = (char*)mapping;
+            isMapped = true;
+        }
+        close(fileFd);
+        return true;
+#else
+        FILE* file = fopen(path, "rb");
+        if (!file) {
+            return false;
+        }
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        data = new char[size > 0 ? size : 1];
+        bool wasRead = size == 0 || fread(data, 1, size, file) == (size_t)size;
+        fclose(file);
+        return wasRead;
+#endif
+    }
+    const char* getData() {
+        return data;
+    }
+    long long getSize() {
+        return size;
+    }
+};
+// IMPORT CHUNK CLASS
+class ImportChunk {
+public:
+    const char* begin;          // First byte of the chunk (start of a line)
+    const char* end;            // One past the last byte (after a newline or at EOF)
+    const char* dataEnd;        // End of the file, the last CSV record may run past end
+    const char* parsedEnd;      // Where the record after the last parsed one starts
+    bool isJsonLines;           // Input format
+    bool mayHaveHeader;         // First chunk of a CSV file
+    Task* tasksHead;            // Parsed tasks, linked through next
+    Task* tasksTail;
+    int taskCount;
+    int rejectedCount;          // Malformed or out-of-range lines
+    Task* queueHeads[5];        // Queue copies per priority, linked through queueNext
+    Task* queueTails[5];
+    int queueCounts[5];
+    // Constructor
+    ImportChunk() {
+        begin = end = dataEnd = parsedEnd = nullptr;
+        isJsonLines = false;
+        mayHaveHeader = false;
+        tasksHead = tasksTail = nullptr;
+        taskCount = 0;
+        rejectedCount = 0;
+        for (int i = 0; i < 5; i++) {
+            queueHeads[i] = queueTails[i] = nullptr;
+            queueCounts[i] = 0;
+        }
+    }
+    // Delete everything parsed so far
+    void discardTasks() {
+        while (tasksHead) {
+            Task* temp = tasksHead;
+            tasksHead = tasksHead->next;
+            delete temp;
+        }
+        tasksTail = nullptr;
+        for (int i = 0; i < 5; i++) {
+            while (queueHeads[i]) {
+                Task* temp = queueHeads[i];
+                queueHeads[i] = queueHeads[i]->queueNext;
+                delete temp;
+            }
+            queueTails[i] = nullptr;
+            queueCounts[i] = 0;
+        }
+        taskCount = 0;
+        rejectedCount = 0;
+    }
+};
+// Parse a non-negative integer filling the whole range (spaces allowed around it)
+bool parseImportNumber(const char* text, const char* textEnd, int& value) {
+    while (text < textEnd && (*text == ' ' || *text == '\t')) {
+        text++;
+    }
+    while (textEnd > text && (textEnd[-1] == ' ' || textEnd[-1] == '\t')) {
+        textEnd--;
+    }
+    if (text == textEnd || textEnd - text > 9) {
+        return false;
+    }
+    value = 0;
+    for (; text < textEnd; text++) {
+        if (*text < '0' || *text > '9') {
+            return false;
+        }
+        value = value * 10 + (*text - '0');
+    }
+    return true;
+}
+// Longest CSV record whose quoted fields may span lines
+const int MAX_CSV_RECORD_LENGTH = 64 * 1024;
+// End of the CSV record that starts at position: the first line break that is
+// not inside a quoted field, or end. A quote that is not properly closed within
+// MAX_CSV_RECORD_LENGTH bytes only spoils its own line.
+const char* findCsvRecordEnd(const char* position, const char* end) {
+    const char* lineEnd = (const char*)memchr(position, '\n', end - position);
+    if (!lineEnd) {
+        lineEnd = end;
+    }
+    if (!memchr(position, '"', lineEnd - position)) {
+        return lineEnd;
+    }
+    const char* scanEnd = end - position > MAX_CSV_RECORD_LENGTH ? position + MAX_CSV_RECORD_LENGTH : end;
+    bool isFieldStart = true;
+    while (position < scanEnd) {
+        if (isFieldStart && *position == '"') {
+            // Quoted field, "" stands for one quote
+            position++;
+            while (position < scanEnd && (*position != '"' || (position + 1 < scanEnd && position[1] == '"'))) {
+                position += *position == '"' ? 2 : 1;
+            }
+            if (position >= scanEnd) {
+                return lineEnd;
+            }
+            position++;
+            if (position < scanEnd && *position != ',' && *position != '\r' && *position != '\n') {
+                return lineEnd;
+            }
+            isFieldStart = false;
+            continue;
+        }
+        if (*position == '\n') {
+            return position;
+        }
+        isFieldStart = *position == ',';
+        position++;
+    }
+    return scanEnd == end ? end : lineEnd;
+}
+// Parse one CSV record into a task, false if it is malformed
+bool parseCsvTaskLine(const char* line, const char* lineEnd, Task& task) {
+    char fields[5][100];
+    int fieldCount = 0;
+    const char* position = line;
+    while (true) {
+        if (fieldCount == 5) {
+            return false;
+        }
+        char* field = fields[fieldCount++];
+        int length = 0;
+        if (position < lineEnd && *position == '"') {
+            // Quoted field, "" stands for one quote
+            position++;
+            while (true) {
+                if (position >= lineEnd) {
+                    return false;
+                }
+                if (*position == '"') {
+                    if (position + 1 < lineEnd && position[1] == '"') {
+                        position++;
+                    } else {
+                        position++;
+                        break;
+                    }
+                }
+                if (length < 99) {
+                    field[length++] = *position;
+                }
+                position++;
+            }
+            if (position < lineEnd && *position != ',') {
+                return false;
+            }
+        } else {
+            while (position < lineEnd && *position != ',') {
+                if (length < 99) {
+                    field[length++] = *position;
+                }
+                position++;
+            }
+        }
+        field[length] = '\0';
+        if (position >= lineEnd) {
+            break;
+        }
+        position++;     // Skip the comma
+    }
+    if (fieldCount < 4) {
+        return false;
+    }
+    int first = fieldCount - 4;     // A fifth leading field is an (ignored) ID
+    strcpy(task.name, fields[first]);
+    return parseImportNumber(fields[first + 1], fields[first + 1] + strlen(fields[first + 1]), task.priority) &&
+           parseImportNumber(fields[first + 2], fields[first + 2] + strlen(fields[first + 2]), task.deadline) &&
+           parseImportNumber(fields[first + 3], fields[first + 3] + strlen(fields[first + 3]), task.duration);
+}
+// Skip JSON whitespace
+const char* skipJsonSpace(const char* position, const char* lineEnd) {
+    while (position < lineEnd && (*position == ' ' || *position == '\t' || *position == '\r')) {
+        position++;
+    }
+    return position;
+}
+// Parse a JSON string into a buffer of 100 characters, returns the position after it or nullptr
+const char* parseJsonString(const char* position, const char* lineEnd, char* buffer) {
+    if (position >= lineEnd || *position != '"') {
+        return nullptr;
+    }
+    position++;
+    int length = 0;
+    while (position < lineEnd && *position != '"') {
+        char character = *position++;
+        if (character == '\\') {
+            if (position >= lineEnd) {
+                return nullptr;
+            }
+            char escape = *position++;
+            switch (escape) {
+                case 'n': character = '\n'; break;
+                case 't': character = '\t'; break;
+                case 'r': character = '\r'; break;
+                case 'b': character = '\b'; break;
+                case 'f': character = '\f'; break;
+                case 'u': {
+                    // Only ASCII code points are kept as-is
+                    int codePoint = 0;
+                    for (int i = 0; i < 4; i++) {
+                        if (position >= lineEnd || !isxdigit((unsigned char)*position)) {
+                            return nullptr;
+                        }
+                        char digit = *position++;
+                        codePoint = codePoint * 16 + (isdigit((unsigned char)digit) ? digit - '0' : (tolower(digit) - 'a' + 10));
+                    }
+                    character = codePoint < 128 ? (char)codePoint : '?';
+                    break;
+                }
+                default: character = escape;
+            }
+        }
+        if (length < 99) {
+            buffer[length++] = character;
+        }
+    }
+    if (position >= lineEnd) {
+        return nullptr;
+    }
+    buffer[length] = '\0';
+    return position + 1;
+}
+// Parse one JSON Lines object into a task, false if it is malformed or incomplete
+bool parseJsonTaskLine(const char* line, const char* lineEnd, Task& task) {
+    const char* position = skipJsonSpace(line, lineEnd);
+    if (position >= lineEnd || *position != '{') {
+        return false;
+    }
+    position = skipJsonSpace(position + 1, lineEnd);
+    int fieldsFound = 0;    // Bit per required field
+    char key[100];
+    char text[100];
+    while (position < lineEnd && *position != '}') {
+        position = parseJsonString(position, lineEnd, key);
+        if (!position) {
+            return false;
+        }
+        position = skipJsonSpace(position, lineEnd);
+        if (position >= lineEnd || *position != ':') {
+            return false;
+        }
+        position = skipJsonSpace(position + 1, lineEnd);
+        if (position < lineEnd && *position == '"') {
+            position = parseJsonString(position, lineEnd, text);
+            if (!position) {
+                return false;
+            }
+            if (strcmp(key, "name") == 0) {
+                strcpy(task.name, text);
+                fieldsFound |= 1;
+            }
+        } else {
+            const char* numberEnd = position;
+            while (numberEnd < lineEnd && *numberEnd != ',' && *numberEnd != '}') {
+                numberEnd++;
+            }
+            int value;
+            if (!parseImportNumber(position, numberEnd, value)) {
+                return false;
+            }
+            if (strcmp(key, "priority") == 0) {
+                task.priority = value;
+                fieldsFound |= 2;
+            } else if (strcmp(key, "deadline") == 0) {
+                task.deadline = value;
+                fieldsFound |= 4;
+            } else if (strcmp(key, "duration") == 0) {
+                task.duration = value;
+                fieldsFound |= 8;
+            }
+            position = numberEnd;
+        }
+        position = skipJsonSpace(position, lineEnd);
+        if (position < lineEnd && *position == ',') {
+            position = skipJsonSpace(position + 1, lineEnd);
+        }
+    }
+    return position < lineEnd && fieldsFound == 15;
+}
+// Parse every line of a chunk (runs on its own thread)
+void parseImportChunk(ImportChunk* chunk) {
+    const char* position = chunk->begin;
+    bool isFirstLine = chunk->mayHaveHeader;
+    Task parsed;
+    while (position < chunk->end) {
+        // A CSV record can span lines when a quoted name contains a line break, so
+        // the last record of a chunk may run past the chunk's end
+        const char* lineEnd = chunk->isJsonLines ? (const char*)memchr(position, '\n', chunk->end - position)
+                                                 : findCsvRecordEnd(position, chunk->dataEnd);
+        if (!lineEnd) {
+            lineEnd = chunk->end;
+        }
+        const char* nextLine = lineEnd < chunk->dataEnd ? lineEnd + 1 : lineEnd;
+        if (lineEnd > position && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+        bool isHeader = isFirstLine;
+        isFirstLine = false;
+        if (lineEnd == position) {
+            position = nextLine;
+            continue;
+        }
+        bool isValid = chunk->isJsonLines ? parseJsonTaskLine(position, lineEnd, parsed)
+                                          : parseCsvTaskLine(position, lineEnd, parsed);
+        isValid = isValid && parsed.priority >= 1 && parsed.priority <= 5 &&
+                  parsed.deadline >= 1 && parsed.deadline <= 30 &&
+                  parsed.duration >= 1 && parsed.duration <= 24;
+        position = nextLine;
+        if (!isValid) {
+            // A CSV header line is not a rejected task
+            if (!isHeader) {
+                chunk->rejectedCount++;
+            }
+            continue;
+        }
+        // IDs are relative to the chunk until the merge assigns the real range
+        Task* newTask = parsed.createCopy();
+        newTask->id = chunk->taskCount++;
+        if (chunk->tasksTail) {
+            chunk->tasksTail->next = newTask;
+        } else {
+            chunk->tasksHead = newTask;
+        }
+        chunk->tasksTail = newTask;
+        
+        int queueIndex = newTask->priority - 1;
+        Task* queueCopy = newTask->createCopy();
+        if (chunk->queueTails[queueIndex]) {
+            chunk->queueTails[queueIndex]->queueNext = queueCopy;
+        } else {
+            chunk->queueHeads[queueIndex] = queueCopy;
+        }
+        chunk->queueTails[queueIndex] = queueCopy;
+        chunk->queueCounts[queueIndex]++;
+    }
+    chunk->parsedEnd = position;
+}
+// Shift a chunk's relative IDs into its part of the allocated range and fill in
+// their ID index entries (runs on its own thread, chunks own disjoint entries)
+void assignImportIds(ImportChunk* chunk, int firstId, TaskHandle* taskHandles) {
+    for (Task* task = chunk->tasksHead; task; task = task->next) {
+        task->id += firstId;
+        taskHandles[task->id].task = task;
+    }
+    for (int i = 0; i < 5; i++) {
+        for (Task* task = chunk->queueHeads[i]; task; task = task->queueNext) {
+            task->id += firstId;
+            taskHandles[task->id].queueCopy = task;
+        }
+    }
+}
+// Returns true for paths ending in .jsonl, .ndjson or .json
+bool isJsonLinesPath(const char* path) {
+    const char* extension = strrchr(path, '.');
+    return extension && (strcmp(extension, ".jsonl") == 0 || strcmp(extension, ".ndjson") == 0 ||
+                         strcmp(extension, ".json") == 0);
+}
+// Import all tasks of a file, false if it cannot be read
+bool TaskManager::importTasks(const char* path, int& importedCount, int& rejectedCount) {
+    importedCount = 0;
+    rejectedCount = 0;
+    MappedFile file;
+    if (!file.openFile(path)) {
+        return false;
+    }
+    const char* data = file.getData();
+    long long size = file.getSize();
+    // One chunk per core, but no chunk smaller than 256 KB
+    int chunkCount = thread::hardware_concurrency();
+    if (chunkCount < 1) {
+        chunkCount = 1;
+    }
+    if (size / (256 * 1024) + 1 < chunkCount) {
+        chunkCount = (int)(size / (256 * 1024)) + 1;
+    }
+    ImportChunk* chunks = new ImportChunk[chunkCount];
+    bool isJsonLines = isJsonLinesPath(path);
+    const char* chunkStart = data;
+    for (int i = 0; i < chunkCount; i++) {
+        const char* chunkEnd = data + size;
+        if (i < chunkCount - 1) {
+            // Move the split point forward to the next line start
+            chunkEnd = data + size * (i + 1) / chunkCount;
+            if (chunkEnd < chunkStart) {
+                chunkEnd = chunkStart;
+            }
+            const char* newline = (const char*)memchr(chunkEnd, '\n', data + size - chunkEnd);
+            chunkEnd = newline ? newline + 1 : data + size;
+        }
+        chunks[i].begin = chunkStart;
+        chunks[i].end = chunkEnd;
+        chunks[i].dataEnd = data + size;
+        chunks[i].isJsonLines = isJsonLines;
+        chunks[i].mayHaveHeader = i == 0 && !isJsonLines;
+        chunkStart = chunkEnd;
+    }
+    // Parse all chunks in parallel
+    thread* workers = new thread[chunkCount];
+    for (int i = 1; i < chunkCount; i++) {
+        workers[i] = thread(parseImportChunk, &chunks[i]);
+    }
+    parseImportChunk(&chunks[0]);
+    for (int i = 1; i < chunkCount; i++) {
+        workers[i].join();
+    }
+    // A split point can fall inside a quoted CSV name, and then the next chunk was
+    // parsed from the middle of a record. Every chunk knows where its last record
+    // really ended, so a chunk that did not start there is parsed again from that
+    // point. Chunk 0 starts at the file start, so each check uses a correct end.
+    for (int i = 1; i < chunkCount; i++) {
+        if (chunks[i].begin != chunks[i - 1].parsedEnd) {
+            chunks[i].discardTasks();
+            chunks[i].begin = chunks[i - 1].parsedEnd;
+            if (chunks[i].end < chunks[i].begin) {
+                chunks[i].end = chunks[i].begin;
+            }
+            parseImportChunk(&chunks[i]);
+        }
+    }
+    // Allocate the whole ID range at once, then fix up the IDs in parallel
+    int firstId = nextAvailableId;
+    for (int i = 0; i < chunkCount; i++) {
+        importedCount += chunks[i].taskCount;
+        rejectedCount += chunks[i].rejectedCount;
+    }
+    nextAvailableId += importedCount;
+    reserveTaskHandles(nextAvailableId - 1);
+    int chunkFirstId = firstId;
+    for (int i = 0; i < chunkCount; i++) {
+        if (i > 0) {
+            workers[i] = thread(assignImportIds, &chunks[i], chunkFirstId, taskHandles);
+        } else {
+            assignImportIds(&chunks[0], chunkFirstId, taskHandles);
+        }
+        chunkFirstId += chunks[i].taskCount;
+    }
+    for (int i = 1; i < chunkCount; i++) {
+        workers[i].join();
+    }
+    delete[] workers;
+    // Splice the chunk chains onto the main list and the priority queues
+    for (int i = 0; i < chunkCount; i++) {
+        ImportChunk& chunk = chunks[i];
+        if (chunk.tasksHead) {
+            if (allTasksTail) {
+                allTasksTail->next = chunk.tasksHead;
+            } else {
+                allTasksList = chunk.tasksHead;
+            }
+            allTasksTail = chunk.tasksTail;
+            allTaskCount += chunk.taskCount;
+        }
+        for (int j = 0; j < 5; j++) {
+            if (chunk.queueHeads[j]) {
+                getPriorityQueue(j + 1)->appendTaskChain(chunk.queueHeads[j], chunk.queueTails[j],
+                                                         chunk.queueCounts[j]);
+            }
+        }
+    }
+    delete[] chunks;
+    if (liveVersion || sharedView) {
+        for (int taskId = firstId; taskId < nextAvailableId; taskId++) {
+            noteTaskChanged(taskId);
+        }
+    }
+    publishSharedView();
+    return true;
+}
+// EXPORT WRITER CLASS
+// Formats task lines into a large buffer and writes it out in big blocks.
+class ExportWriter {
+private:
+    FILE* file;
+    char* buffer;
+    int used;
+    static const int BUFFER_SIZE = 1 << 20;
+public:
+    // Constructor
+    ExportWriter(FILE* outputFile) {
+        file = outputFile;
+        buffer = new char[BUFFER_SIZE];
+        used = 0;
+    }
+    // Destructor
+    ~ExportWriter() {
+        flush();
+        delete[] buffer;
+    }
+    // Write the buffered bytes, false on a write error
+    bool flush() {
+        bool wasWritten = used == 0 || fwrite(buffer, 1, used, file) == (size_t)used;
+        used = 0;
+        return wasWritten;
+    }
+    // Append text (callers keep single appends far below BUFFER_SIZE)
+    void appendText(const char* text, int length) {
+        if (used + length > BUFFER_SIZE) {
+            flush();
+        }
+        memcpy(buffer + used, text, length);
+        used += length;
+    }
+    void appendText(const char* text) {
+        appendText(text, strlen(text));
+    }
+    void appendNumber(int value) {
+        char digits[12];
+        int length = 0;
+        unsigned int remaining = value < 0 ? -(unsigned int)value : value;
+        do {
+            digits[length++] = '0' + remaining % 10;
+            remaining /= 10;
+        } while (remaining);
+        if (value < 0) {
+            digits[length++] = '-';
+        }
+        char ordered[12];
+        for (int i = 0; i < length; i++) {
+            ordered[i] = digits[length - 1 - i];
+        }
+        appendText(ordered, length);
+    }
+    // Quote a CSV field when it contains a comma or a quote
+    void appendCsvName(const char* name) {
+        if (!strpbrk(name, ",\"\r\n")) {
+            appendText(name);
+            return;
+        }
+        appendText("\"", 1);
+        for (const char* character = name; *character; character++) {
+            appendText(character, 1);
+            if (*character == '"') {
+                appendText("\"", 1);
+            }
+        }
+        appendText("\"", 1);
+    }
+    // Escape a JSON string
+    void appendJsonName(const char* name) {
+        appendText("\"", 1);
+        for (const char* character = name; *character; character++) {
+            unsigned char code = *character;
+            if (code == '"' || code == '\\') {
+                appendText("\\", 1);
+                appendText(character, 1);
+            } else if (code < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", code);
+                appendText(escaped, 6);
+            } else {
+                appendText(character, 1);
+            }
+        }
+        appendText("\"", 1);
+    }
+};
+// Stream a task list to a file, false if it cannot be written
+bool TaskManager::exportTasks(const char* path, int listType, int& exportedCount) {
+    exportedCount = 0;
+    Task* listHead = allTasksList;
+    if (listType == SCHEDULED_TASKS_LIST) {
+        listHead = scheduledTasksList;
+    } else if (listType == PENDING_TASKS_LIST) {
+        listHead = pendingTasksList;
+    }
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool isJsonLines = isJsonLinesPath(path);
+    bool wasWritten;
+    {
+        ExportWriter writer(file);
+        if (!isJsonLines) {
+            writer.appendText("id,name,priority,deadline,duration\n");
+        }
+        for (Task* task = listHead; task; task = task->next) {
+            if (task->isTombstone) {
+                continue;
+            }
+            if (isJsonLines) {
+                writer.appendText("{\"id\":");
+                writer.appendNumber(task->id);
+                writer.appendText(",\"name\":");
+                writer.appendJsonName(task->name);
+                writer.appendText(",\"priority\":");
+                writer.appendNumber(task->priority);
+                writer.appendText(",\"deadline\":");
+                writer.appendNumber(task->deadline);
+                writer.appendText(",\"duration\":");
+                writer.appendNumber(task->duration);
+                writer.appendText("}\n");
+            } else {
+                writer.appendNumber(task->id);
+                writer.appendText(",", 1);
+                writer.appendCsvName(task->name);
+                writer.appendText(",", 1);
+                writer.appendNumber(task->priority);
+                writer.appendText(",", 1);
+                writer.appendNumber(task->deadline);
+                writer.appendText(",", 1);
+                writer.appendNumber(task->duration);
+                writer.appendText("\n", 1);
+            }
+            exportedCount++;
+        }
+        wasWritten = writer.flush();
+    }
+    return fclose(file) == 0 && wasWritten;
+}
+// BYTE BUFFER CLASS FOR SOCKET I/O
+class ByteBuffer {
+private:
+    char* data;             // Heap storage
+    int readOffset;         // Index of the first unread byte
+    int writeOffset;        // Index one past the last written byte
+    int capacity;           // Allocated size of data
+    // Make room for count more bytes at the end
+    void ensureSpace(int count) {
+        if (writeOffset + count <= capacity) {
+            return;
+        }
+        int usedBytes = writeOffset - readOffset;
+        // Slide unread bytes to the front if that frees enough room
+        if (readOffset > 0 && usedBytes + count <= capacity) {
+            memmove(data, data + readOffset, usedBytes);
+            readOffset = 0;
+            writeOffset = usedBytes;
+            return;
+        }
+        int newCapacity = capacity > 0 ? capacity * 2 : 256;
+        while (newCapacity < usedBytes + count) {
+            newCapacity *= 2;
+        }
+        char* newData = new char[newCapacity];
+        if (usedBytes > 0) {
+            memcpy(newData, data + readOffset, usedBytes);
+        }
+        delete[] data;
+        data = newData;
+        capacity = newCapacity;
+        readOffset = 0;
+        writeOffset = usedBytes;
+    }
+public:
+    // Constructor
+    ByteBuffer() {
+        data = nullptr;
+        readOffset = 0;
+        writeOffset = 0;
+        capacity = 0;
+    }
+    // Destructor
+    ~ByteBuffer() {
+        delete[] data;
+    }
+    // Append raw bytes
+    void appendBytes(const void* bytes, int count) {
+        ensureSpace(count);
+        memcpy(data + writeOffset, bytes, count);
+        writeOffset += count;
+    }
+    // Append little-endian integers
+    void appendU8(unsigned int value) {
+        unsigned char bytes[1] = { (unsigned char)value };
+        appendBytes(bytes, 1);
+    }
+    void appendU16(unsigned int value) {
+        unsigned char bytes[2] = { (unsigned char)value, (unsigned char)(value >> 8) };
+        appendBytes(bytes, 2);
+    }
+    void appendU32(unsigned int value) {
+        unsigned char bytes[4] = { (unsigned char)value, (unsigned char)(value >> 8),
+                                   (unsigned char)(value >> 16), (unsigned char)(value >> 24) };
+        appendBytes(bytes, 4);
+    }
+    // Overwrite a 32-bit value at a position relative to the first unread byte
+    void patchU32(int position, unsigned int value) {
+        unsigned char* target = (unsigned char*)data + readOffset + position;
+        target[0] = (unsigned char)value;
+        target[1] = (unsigned char)(value >> 8);
+        target[2] = (unsigned char)(value >> 16);
+        target[3] = (unsigned char)(value >> 24);
+    }
+    // Reserve space for a direct read() and commit the bytes actually read
+    char* reserveTail(int count) {
+        ensureSpace(count);
+        return data + writeOffset;
+    }
+    void commitTail(int count) {
+        writeOffset += count;
+    }
+    // Access and consume unread bytes
+    const char* readPointer() {
+        return data + readOffset;
+    }
+    int readableBytes() {
+        return writeOffset - readOffset;
+    }
+    void consumeBytes(int count) {
+        readOffset += count;
+        if (readOffset == writeOffset) {
+            readOffset = 0;
+            writeOffset = 0;
+        }
+    }
+};
+// FRAME READER CLASS FOR DECODING PROTOCOL MESSAGES
+class FrameReader {
+private:
+    const unsigned char* position;  // Next byte to decode
+    int remaining;                  // Bytes left in the frame
+public:
+    // Constructor
+    FrameReader(const char* bytes, int length) {
+        position = (const unsigned char*)bytes;
+        remaining = length;
+    }
+    // Decode little-endian integers, false if the frame is too short
+    bool readU8(int& value) {
+        if (remaining < 1) {
+            return false;
+        }
+        value = position[0];
+        position += 1;
+        remaining -= 1;
+        return true;
+    }
+    bool readU16(int& value) {
+        if (remaining < 2) {
+            return false;
+        }
+        value = position[0] | (position[1] << 8);
+        position += 2;
+        remaining -= 2;
+        return true;
+    }
+    bool readU32(unsigned int& value) {
+        if (remaining < 4) {
+            return false;
+        }
+        value = (unsigned int)position[0] | ((unsigned int)position[1] << 8) |
+                ((unsigned int)position[2] << 16) | ((unsigned int)position[3] << 24);
+        position += 4;
+        remaining -= 4;
+        return true;
+    }
+    // Copy length bytes into a null-terminated buffer of 100 characters
+    bool readName(char* buffer, int length) {
+        if (length > 99 || remaining < length) {
+            return false;
+        }
+        memcpy(buffer, position, length);
+        buffer[length] = '\0';
+        position += length;
+        remaining -= length;
+        return true;
+    }
+    int getRemaining() {
+        return remaining;
+    }
+};
+// SCHEDULER PROTOCOL
+// Every message is a frame: [u32 length][u8 opcode][u32 request ID][u32 tenant ID][body].
+// The length counts everything after itself and all integers are little-endian.
+// Responses echo the opcode, request ID and tenant ID followed by a u8 status, so a
+// client may pipeline many requests on one connection and match replies by ID.
+// Each tenant ID addresses its own independent TaskManager.
+// A task record is [u8 priority][u8 deadline][u8 duration][u8 name length][name].
+enum ProtocolOpcode {
+    OP_CREATE = 1,          // task record -> u32 id
+    OP_CREATE_BATCH = 2,    // u16 count, records -> u16 count, u32 id each (0 = rejected)
+    OP_UPDATE = 3,          // u32 id, task record (0 / empty name keeps a value)
+    OP_DELETE = 4,          // u32 id
+    OP_SCHEDULE = 5,        // u32 id -> u8 scheduled (1) or pending (0)
+    OP_SCHEDULE_ALL = 6,    // -> u32 scheduled, u32 pending
+    OP_UNDO = 7,            // -> u32 id, u8 moved to pending
+    OP_QUERY_TASK = 8,      // u32 id -> u32 id, task record
+    OP_QUERY_STATS = 9      // -> u32 all, u32 scheduled, u32 pending
+};
+enum ProtocolStatus {
+    STATUS_OK = 0,
+    STATUS_NOT_FOUND = 1,
+    STATUS_INVALID = 2,
+    STATUS_NOTHING_TO_UNDO = 3,
+    STATUS_BAD_REQUEST = 4,
+    STATUS_TENANT_LIMIT = 5         // New tenant refused, the daemon serves its maximum
+};
+const int FRAME_PREFIX_SIZE = 4;            // Length field
+const int FRAME_HEADER_SIZE = 9;            // Opcode + request ID + tenant ID
+const int MAX_FRAME_LENGTH = 1 << 20;       // Largest accepted frame
+const int MAX_BATCH_TASKS = 4096;           // Largest accepted create batch
+// Start a frame, returns its position for endFrame
+int beginFrame(ByteBuffer& buffer, int opcode, unsigned int requestId, unsigned int tenantId) {
+    int framePosition = buffer.readableBytes();
+    buffer.appendU32(0);
+    buffer.appendU8(opcode);
+    buffer.appendU32(requestId);
+    buffer.appendU32(tenantId);
+    return framePosition;
+}
+// Fill in the length of a finished frame
+void endFrame(ByteBuffer& buffer, int framePosition) {
+    int frameLength = buffer.readableBytes() - framePosition - FRAME_PREFIX_SIZE;
+    buffer.patchU32(framePosition, frameLength);
+}
+// Encode a task record
+void appendTaskRecord(ByteBuffer& buffer, const char* name, int priority, int deadline, int duration) {
+    int nameLength = strlen(name);
+    if (nameLength > 99) {
+        nameLength = 99;
+    }
+    buffer.appendU8(priority);
+    buffer.appendU8(deadline);
+    buffer.appendU8(duration);
+    buffer.appendU8(nameLength);
+    buffer.appendBytes(name, nameLength);
+}
+// Decode a task record
+bool readTaskRecord(FrameReader& reader, Task& record) {
+    int nameLength;
+    return reader.readU8(record.priority) && reader.readU8(record.deadline) &&
+           reader.readU8(record.duration) && reader.readU8(nameLength) &&
+           reader.readName(record.name, nameLength);
+}
+// Append a response that carries only a status
+void appendStatusResponse(ByteBuffer& output, int opcode, unsigned int requestId, unsigned int tenantId, int status) {
+    int framePosition = beginFrame(output, opcode, requestId, tenantId);
+    output.appendU8(status);
+    endFrame(output, framePosition);
+}
+// Execute one request frame against a task manager and append the response
+void processRequestFrame(TaskManager& manager, int opcode, unsigned int requestId, unsigned int tenantId,
+                         const char* body, int bodyLength, ByteBuffer& output) {
+    FrameReader reader(body, bodyLength);
+    Task record;
+    unsigned int taskId = 0;
+    int framePosition = beginFrame(output, opcode, requestId, tenantId);
+    switch (opcode) {
+        case OP_CREATE: {
+            if (!readTaskRecord(reader, record)) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            int newId = manager.createTask(record.name, record.priority, record.deadline, record.duration);
+            output.appendU8(newId ? STATUS_OK : STATUS_INVALID);
+            output.appendU32(newId);
+            break;
+        }
+        case OP_CREATE_BATCH: {
+            int taskCount;
+            if (!reader.readU16(taskCount) || taskCount > MAX_BATCH_TASKS) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            // Validate the whole batch before creating anything
+            FrameReader validator = reader;
+            bool isWellFormed = true;
+            for (int i = 0; i < taskCount && isWellFormed; i++) {
+                isWellFormed = readTaskRecord(validator, record);
+            }
+            if (!isWellFormed) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            output.appendU8(STATUS_OK);
+            output.appendU16(taskCount);
+            for (int i = 0; i < taskCount; i++) {
+                readTaskRecord(reader, record);
+                output.appendU32(manager.createTask(record.name, record.priority,
+                                                    record.deadline, record.duration));
+            }
+            break;
+        }
+        case OP_UPDATE: {
+            if (!reader.readU32(taskId) || !readTaskRecord(reader, record)) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            bool wasUpdated = manager.updateTask(taskId, record.name, record.priority,
+                                                 record.deadline, record.duration);
+            output.appendU8(wasUpdated ? STATUS_OK : STATUS_NOT_FOUND);
+            break;
+        }
+        case OP_DELETE: {
+            if (!reader.readU32(taskId)) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            output.appendU8(manager.deleteTask(taskId) ? STATUS_OK : STATUS_NOT_FOUND);
+            break;
+        }
+        case OP_SCHEDULE: {
+            if (!reader.readU32(taskId)) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            int result = manager.scheduleTask(taskId);
+            if (result == TASK_NOT_FOUND) {
+                output.appendU8(STATUS_NOT_FOUND);
+            } else {
+                output.appendU8(STATUS_OK);
+                output.appendU8(result == TASK_SCHEDULED ? 1 : 0);
+            }
+            break;
+        }
+        case OP_SCHEDULE_ALL: {
+            int scheduledCount, pendingCount;
+            manager.scheduleAllTasks(scheduledCount, pendingCount);
+            output.appendU8(STATUS_OK);
+            output.appendU32(scheduledCount);
+            output.appendU32(pendingCount);
+            break;
+        }
+        case OP_UNDO: {
+            bool movedToPending;
+            int undoneId = manager.undoLastSchedule(movedToPending);
+            if (!undoneId) {
+                output.appendU8(STATUS_NOTHING_TO_UNDO);
+            } else {
+                output.appendU8(STATUS_OK);
+                output.appendU32(undoneId);
+                output.appendU8(movedToPending ? 1 : 0);
+            }
+            break;
+        }
+        case OP_QUERY_TASK: {
+            if (!reader.readU32(taskId)) {
+                output.appendU8(STATUS_BAD_REQUEST);
+                break;
+            }
+            if (!manager.getTaskDetails(taskId, record)) {
+                output.appendU8(STATUS_NOT_FOUND);
+                break;
+            }
+            output.appendU8(STATUS_OK);
+            output.appendU32(record.id);
+            appendTaskRecord(output, record.name, record.priority, record.deadline, record.duration);
+            break;
+        }
+        case OP_QUERY_STATS: {
+            int allCount, scheduledCount, pendingCount;
+            manager.getTaskCounts(allCount, scheduledCount, pendingCount);
+            output.appendU8(STATUS_OK);
+            output.appendU32(allCount);
+            output.appendU32(scheduledCount);
+            output.appendU32(pendingCount);
+            break;
+        }
+        default:
+            output.appendU8(STATUS_BAD_REQUEST);
+    }
+    endFrame(output, framePosition);
+}
+// Split the first complete frame off a buffer, false if more bytes are needed
+// (frameLength is set to -1 when the frame is malformed)
+bool peekFrame(ByteBuffer& buffer, int& frameLength, int& opcode, unsigned int& requestId,
+               unsigned int& tenantId) {
+    frameLength = 0;
+    if (buffer.readableBytes() < FRAME_PREFIX_SIZE) {
+        return false;
+    }
+    FrameReader prefix(buffer.readPointer(), buffer.readableBytes());
+    unsigned int length = 0;
+    prefix.readU32(length);
+    if (length < (unsigned int)FRAME_HEADER_SIZE || length > (unsigned int)MAX_FRAME_LENGTH) {
+        frameLength = -1;
+        return false;
+    }
+    if (buffer.readableBytes() < FRAME_PREFIX_SIZE + (int)length) {
+        return false;
+    }
+    frameLength = length;
+    prefix.readU8(opcode);
+    prefix.readU32(requestId);
+    prefix.readU32(tenantId);
+    return true;
+}
+// TENANT SETTINGS CLASS
+// Daemon-wide tenant configuration from the command line, shared by the tenant
+// tables of the daemon and of every shard worker. Tenant IDs come from clients,
+// so the number of tenants is capped across all tables.
+const int DEFAULT_MAX_TENANTS = 4096;
+class TenantSettings {
+public:
+    int maxTenants;                     // Most tenants the daemon serves
+    atomic<int> tenantCount;            // Tenants created so far by all tables
+    const char* sharedViewPrefix;       // Views are named "<prefix>-<tenant ID>", nullptr if none
+    unsigned int* sharedViewTenantIds;  // Tenants that publish a view
+    int sharedViewTenantCount;
+    // Constructor
+    TenantSettings() {
+        maxTenants = DEFAULT_MAX_TENANTS;
+        tenantCount.store(0);
+        sharedViewPrefix = nullptr;
+        sharedViewTenantIds = nullptr;
+        sharedViewTenantCount = 0;
+    }
+    // Destructor
+    ~TenantSettings() {
+        delete[] sharedViewTenantIds;
+    }
+    // True if a tenant was configured to publish a view
+    bool isSharedViewTenant(unsigned int tenantId) {
+        for (int i = 0; sharedViewPrefix && i < sharedViewTenantCount; i++) {
+            if (sharedViewTenantIds[i] == tenantId) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+// TENANT TABLE CLASS
+// Hash table from tenant ID to its TaskManager. Managers are created on first
+// use, and an idle one allocates no queues or lists (see TaskManager constructor).
+class TenantTable {
+private:
+    class TenantEntry {
+    public:
+        unsigned int tenantId;      // Tenant key
+        TaskManager* manager;       // Scheduler owned by this tenant
+        TenantEntry* next;          // Next entry in the same bucket
+    };
+    TenantEntry** buckets;          // Chained buckets
+    int bucketCount;                // Always a power of two
+    int tenantCount;                // Number of entries
+    TenantSettings* settings;       // Daemon-wide configuration
+    // Bucket index for a tenant ID
+    int bucketFor(unsigned int tenantId) {
+        return (int)((tenantId * 2654435761u) >> 7) & (bucketCount - 1);
+    }
+    // Double the bucket array once the table is full
+    void growBuckets() {
+        TenantEntry** oldBuckets = buckets;
+        int oldCount = bucketCount;
+        bucketCount *= 2;
+        buckets = new TenantEntry*[bucketCount];
+        for (int i = 0; i < bucketCount; i++) {
+            buckets[i] = nullptr;
+        }
+        for (int i = 0; i < oldCount; i++) {
+            while (oldBuckets[i]) {
+                TenantEntry* entry = oldBuckets[i];
+                oldBuckets[i] = entry->next;
+                int index = bucketFor(entry->tenantId);
+                entry->next = buckets[index];
+                buckets[index] = entry;
+            }
+        }
+        delete[] oldBuckets;
+    }
+public:
+    // Constructor
+    TenantTable(TenantSettings* tenantSettings) {
+        settings = tenantSettings;
+        bucketCount = 16;
+        tenantCount = 0;
+        buckets = new TenantEntry*[bucketCount];
+        for (int i = 0; i < bucketCount; i++) {
+            buckets[i] = nullptr;
+        }
+    }
+    // Destructor
+    ~TenantTable() {
+        for (int i = 0; i < bucketCount; i++) {
+            while (buckets[i]) {
+                TenantEntry* entry = buckets[i];
+                buckets[i] = entry->next;
+                delete entry->manager;
+                delete entry;
+            }
+        }
+        delete[] buckets;
+        settings->tenantCount.fetch_sub(tenantCount);
+    }
+    // Find the manager of a tenant, creating it on first use. Returns nullptr if
+    // the tenant is new and the daemon already serves its maximum.
+    TaskManager* getManager(unsigned int tenantId) {
+        int index = bucketFor(tenantId);
+        for (TenantEntry* entry = buckets[index]; entry; entry = entry->next) {
+            if (entry->tenantId == tenantId) {
+                return entry->manager;
+            }
+        }
+        if (settings->tenantCount.fetch_add(1) >= settings->maxTenants) {
+            settings->tenantCount.fetch_sub(1);
+            return nullptr;
+        }
+        if (tenantCount >= bucketCount) {
+            growBuckets();
+            index = bucketFor(tenantId);
+        }
+        TenantEntry* entry = new TenantEntry();
+        entry->tenantId = tenantId;
+        entry->manager = new TaskManager();
+        entry->manager->setVerboseOutput(false);
+        if (settings->isSharedViewTenant(tenantId)) {
+            char viewName[256];
+            snprintf(viewName, sizeof(viewName), "%s-%u", settings->sharedViewPrefix, tenantId);
+            if (!entry->manager->enableSharedView(viewName, DEFAULT_SHARED_VIEW_CAPACITY)) {
+                cout << "Warning: Could not create shared view " << viewName << ": " << strerror(errno) << endl;
+            }
+        }
+        entry->next = buckets[index];
+        buckets[index] = entry;
+        tenantCount++;
+        return entry->manager;
+    }
+    int getTenantCount() {
+        return tenantCount;
+    }
+};
+// SHARD REQUEST CLASS
+class ShardRequest {
+public:
+    int opcode;                 // Decoded frame header
+    unsigned int requestId;
+    unsigned int tenantId;
+    char* body;                 // Copy of the frame body
+    int bodyLength;
+    ByteBuffer response;        // Response frame written by the worker
+    void* owner;                // Submitter's context (e.g. the client connection)
+    ShardRequest* next;         // Next request in a work or completion list
+    // Constructor
+    ShardRequest(int requestOpcode, unsigned int id, unsigned int tenant,
+                 const char* requestBody, int length, void* requestOwner) {
+        opcode = requestOpcode;
+        requestId = id;
+        tenantId = tenant;
+        body = new char[length > 0 ? length : 1];
+        memcpy(body, requestBody, length);
+        bodyLength = length;
+        owner = requestOwner;
+        next = nullptr;
+    }
+    // Destructor
+    ~ShardRequest() {
+        delete[] body;
+    }
+};
+// SHARDED TASK HOST CLASS
+// Runs many tenants' TaskManagers on a fixed set of worker threads. Every tenant
+// belongs to exactly one worker (chosen by hashing its ID), so a TaskManager is
+// only ever touched by one thread and needs no locking. The only lock a worker
+// takes guards its own work and completion lists, which it shares with the
+// thread submitting requests, never with other workers.
+class ShardedTaskHost {
+private:
+    class ShardWorker {
+    public:
+        thread workerThread;
+        mutex listLock;                 // Guards the three lists and isStopping
+        condition_variable wakeSignal;
+        ShardRequest* workHead;         // Requests waiting to run (FIFO)
+        ShardRequest* workTail;
+        ShardRequest* completedHead;    // Finished requests (FIFO)
+        ShardRequest* completedTail;
+        ShardRequest* stagedHead;       // Submitted but not yet handed over, submitter thread only
+        ShardRequest* stagedTail;
+        bool isStopping;
+        TenantTable* tenants;           // Only used by workerThread
+        // Constructor
+        ShardWorker() {
+            workHead = workTail = nullptr;
+            completedHead = completedTail = nullptr;
+            stagedHead = stagedTail = nullptr;
+            isStopping = false;
+            tenants = nullptr;
+        }
+    };
+    ShardWorker* workers;
+    int workerCount;
+    void (*completionCallback)(void* context);  // Called when a worker's completion list becomes non-empty
+    void* completionContext;
+    void runWorker(int workerIndex);
+    static void appendToList(ShardRequest*& head, ShardRequest*& tail, ShardRequest* first, ShardRequest* last);
+public:
+    // Constructor
+    ShardedTaskHost(int threadCount, TenantSettings* settings, void (*onCompleted)(void* context), void* context) {
+        workerCount = threadCount;
+        workers = new ShardWorker[workerCount];
+        for (int i = 0; i < workerCount; i++) {
+            workers[i].tenants = new TenantTable(settings);
+        }
+        completionCallback = onCompleted;
+        completionContext = context;
+    }
+    // Destructor
+    ~ShardedTaskHost();
+    void start();
+    void submitRequest(ShardRequest* request);
+    void flushSubmissions();
+    ShardRequest* collectCompleted();
+    int getWorkerCount() {
+        return workerCount;
+    }
+};
+// Append the chain first..last to a list
+void ShardedTaskHost::appendToList(ShardRequest*& head, ShardRequest*& tail, ShardRequest* first, ShardRequest* last) {
+    if (tail) {
+        tail->next = first;
+    } else {
+        head = first;
+    }
+    tail = last;
+}
+// Start one thread per worker, pinned to its own core where supported
+void ShardedTaskHost::start() {
+    int coreCount = thread::hardware_concurrency();
+    for (int i = 0; i < workerCount; i++) {
+        workers[i].workerThread = thread(&ShardedTaskHost::runWorker, this, i);
+#ifdef __linux__
+        if (coreCount > 0) {
+            cpu_set_t coreSet;
+            CPU_ZERO(&coreSet);
+            CPU_SET(i % coreCount, &coreSet);
+            pthread_setaffinity_np(workers[i].workerThread.native_handle(), sizeof(coreSet), &coreSet);
+        }
+#else
+        (void)coreCount;
+#endif
+    }
+}
+// Stop the workers and release anything left in their lists
+ShardedTaskHost::~ShardedTaskHost() {
+    for (int i = 0; i < workerCount; i++) {
+        {
+            lock_guard<mutex> guard(workers[i].listLock);
+            workers[i].isStopping = true;
+        }
+        workers[i].wakeSignal.notify_one();
+        if (workers[i].workerThread.joinable()) {
+            workers[i].workerThread.join();
+        }
+        ShardRequest* lists[3] = { workers[i].workHead, workers[i].completedHead, workers[i].stagedHead };
+        for (int j = 0; j < 3; j++) {
+            while (lists[j]) {
+                ShardRequest* temp = lists[j];
+                lists[j] = lists[j]->next;
+                delete temp;
+            }
+        }
+        delete workers[i].tenants;
+    }
+    delete[] workers;
+}
+// Queue a request for its tenant's worker (handed over by flushSubmissions)
+void ShardedTaskHost::submitRequest(ShardRequest* request) {
+    ShardWorker& worker = workers[((request->tenantId * 2654435761u) >> 16) % workerCount];
+    request->next = nullptr;
+    appendToList(worker.stagedHead, worker.stagedTail, request, request);
+}
+// Hand all staged requests to the workers, one lock per worker per batch
+void ShardedTaskHost::flushSubmissions() {
+    for (int i = 0; i < workerCount; i++) {
+        ShardWorker& worker = workers[i];
+        if (!worker.stagedHead) {
+            continue;
+        }
+        bool wasIdle;
+        {
+            lock_guard<mutex> guard(worker.listLock);
+            wasIdle = worker.workHead == nullptr;
+            appendToList(worker.workHead, worker.workTail, worker.stagedHead, worker.stagedTail);
+        }
+        worker.stagedHead = worker.stagedTail = nullptr;
+        if (wasIdle) {
+            worker.wakeSignal.notify_one();
+        }
+    }
+}
+// Take every finished request from every worker
+ShardRequest* ShardedTaskHost::collectCompleted() {
+    ShardRequest* resultHead = nullptr;
+    ShardRequest* resultTail = nullptr;
+    for (int i = 0; i < workerCount; i++) {
+        ShardRequest* first;
+        ShardRequest* last;
+        {
+            lock_guard<mutex> guard(workers[i].listLock);
+            first = workers[i].completedHead;
+            last = workers[i].completedTail;
+            workers[i].completedHead = workers[i].completedTail = nullptr;
+        }
+        if (first) {
+            appendToList(resultHead, resultTail, first, last);
+        }
+    }
+    return resultHead;
+}
+// Worker loop: take the whole work list, run it, publish the results
+void ShardedTaskHost::runWorker(int workerIndex) {
+    ShardWorker& worker = workers[workerIndex];
+    while (true) {
+        ShardRequest* batch;
+        {
+            unique_lock<mutex> guard(worker.listLock);
+            while (!worker.workHead && !worker.isStopping) {
+                worker.wakeSignal.wait(guard);
+            }
+            if (!worker.workHead) {
+                return;
+            }
+            batch = worker.workHead;
+            worker.workHead = worker.workTail = nullptr;
+        }
+        ShardRequest* last = batch;
+        for (ShardRequest* request = batch; request; request = request->next) {
+            TaskManager* manager = worker.tenants->getManager(request->tenantId);
+            if (manager) {
+                processRequestFrame(*manager, request->opcode, request->requestId, request->tenantId,
+                                    request->body, request->bodyLength, request->response);
+            } else {
+                appendStatusResponse(request->response, request->opcode, request->requestId,
+                                     request->tenantId, STATUS_TENANT_LIMIT);
+            }
+            last = request;
+        }
+        bool wasEmpty;
+        {
+            lock_guard<mutex> guard(worker.listLock);
+            wasEmpty = worker.completedHead == nullptr;
+            appendToList(worker.completedHead, worker.completedTail, batch, last);
+        }
+        if (wasEmpty && completionCallback) {
+            completionCallback(completionContext);
+        }
+    }
+}
+#ifdef __linux__
+// SCHEDULER DAEMON (UNIX DOMAIN SOCKET + EPOLL)
+volatile sig_atomic_t daemonStopRequested = 0;
+// Signal handler for SIGINT / SIGTERM
+void handleDaemonStopSignal(int) {
+    daemonStopRequested = 1;
+}
+// CLIENT CONNECTION CLASS
+class DaemonConnection {
+public:
+    int socketFd;               // Connected socket
+    ByteBuffer inputBuffer;     // Bytes received but not yet processed
+    ByteBuffer outputBuffer;    // Responses not yet written
+    unsigned int eventMask;     // Events currently registered with epoll
+    int requestsInFlight;       // Requests handed to shard workers and not yet answered
+    bool isInputClosed;         // Client shut down its sending side, replies are still sent
+    bool isClosed;              // Socket closed, object freed after the current event batch
+                                // once requestsInFlight is 0
+    bool isTouched;             // Received worker responses in the current delivery round
+    DaemonConnection* nextTouched;
+    DaemonConnection* previous; // Neighbours in the open connection list
+    DaemonConnection* next;
+    // Constructor
+    DaemonConnection(int fd) {
+        socketFd = fd;
+        eventMask = 0;
+        requestsInFlight = 0;
+        isInputClosed = false;
+        isClosed = false;
+        isTouched = false;
+        nextTouched = nullptr;
+        previous = nullptr;
+        next = nullptr;
+    }
+};
+// SCHEDULER DAEMON CLASS
+class SchedulerDaemon {
+private:
+    TenantSettings* tenantSettings;     // Shared with the shard workers
+    TenantTable* tenants;               // Tenant schedulers when running without workers
+    ShardedTaskHost* shardHost;         // Tenant schedulers on worker threads, or nullptr
+    const char* socketPath;             // Filesystem path of the listening socket
+    int listenFd;                       // Listening socket
+    int epollFd;                        // Event loop
+    int completionFd;                   // eventfd raised by shard workers
+    DaemonConnection* connectionsHead;  // All open connections
+    DaemonConnection* closingHead;      // Closed connections, freed between event batches
+    // Stop reading from a client that does not collect its responses
+    static const int MAX_PENDING_OUTPUT = 4 << 20;
+    static const int MAX_REQUESTS_IN_FLIGHT = 4096;
+    static void notifyCompletion(void* context);
+    void acceptConnections();
+    void deliverCompleted();
+    void handleEvents(DaemonConnection* connection, unsigned int events);
+    bool readInput(DaemonConnection* connection);
+    bool processFrames(DaemonConnection* connection);
+    bool flushOutput(DaemonConnection* connection);
+    bool updateEventMask(DaemonConnection* connection);
+    void unlinkConnection(DaemonConnection*& listHead, DaemonConnection* connection);
+    void closeConnection(DaemonConnection* connection);
+    void releaseClosedConnections();
+public:
+    // Constructor
+    SchedulerDaemon(const char* path, TenantSettings* settings) {
+        tenantSettings = settings;
+        tenants = new TenantTable(settings);
+        shardHost = nullptr;
+        socketPath = path;
+        listenFd = -1;
+        epollFd = -1;
+        completionFd = -1;
+        connectionsHead = nullptr;
+        closingHead = nullptr;
+    }
+    // Destructor
+    ~SchedulerDaemon();
+    bool start(int workerThreads);
+    void run();
+};
+// Close every connection and the listening socket
+SchedulerDaemon::~SchedulerDaemon() {
+    // Stop the workers first, unanswered requests are dropped with them
+    delete shardHost;
+    while (connectionsHead) {
+        connectionsHead->requestsInFlight = 0;
+        closeConnection(connectionsHead);
+    }
+    while (closingHead) {
+        DaemonConnection* temp = closingHead;
+        closingHead = closingHead->next;
+        delete temp;
+    }
+    if (completionFd >= 0) {
+        close(completionFd);
+    }
+    if (listenFd >= 0) {
+        close(listenFd);
+        unlink(socketPath);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+    delete tenants;
+}
+// Tags that tell the event loop which epoll events are not client connections
+static char listenerTag;
+static char completionTag;
+// Create the listening socket, the epoll instance and the optional shard workers
+bool SchedulerDaemon::start(int workerThreads) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socketPath) >= sizeof(address.sun_path)) {
+        cout << "Error: Socket path is too long." << endl;
+        return false;
+    }
+    strcpy(address.sun_path, socketPath);
+    // Only a stale socket left by a previous run may be removed: nothing must be
+    // accepting on it, and a path that is not a socket is never touched
+    int probeFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probeFd < 0) {
+        cout << "Error: Could not create socket: " << strerror(errno) << endl;
+        return false;
+    }
+    int probeResult = connect(probeFd, (sockaddr*)&address, sizeof(address));
+    int probeError = errno;
+    close(probeFd);
+    if (probeResult == 0) {
+        cout << "Error: Another process is already listening on " << socketPath << "." << endl;
+        return false;
+    }
+    struct stat pathStatus;
+    if (probeError == ECONNREFUSED) {
+        if (lstat(socketPath, &pathStatus) != 0 || !S_ISSOCK(pathStatus.st_mode)) {
+            cout << "Error: " << socketPath << " exists and is not a socket." << endl;
+            return false;
+        }
+        unlink(socketPath);
+    } else if (probeError != ENOENT) {
+        cout << "Error: Could not use " << socketPath << ": " << strerror(probeError) << endl;
+        return false;
+    }
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        cout << "Error: Could not create socket: " << strerror(errno) << endl;
+        return false;
+    }
+    if (bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, SOMAXCONN) < 0) {
+        cout << "Error: Could not listen on " << socketPath << ": " << strerror(errno) << endl;
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) {
+        cout << "Error: Could not create epoll instance: " << strerror(errno) << endl;
+        return false;
+    }
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.ptr = &listenerTag;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    if (workerThreads > 0) {
+        completionFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (completionFd < 0) {
+            cout << "Error: Could not create eventfd: " << strerror(errno) << endl;
+            return false;
+        }
+        event.data.ptr = &completionTag;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, completionFd, &event);
+        shardHost = new ShardedTaskHost(workerThreads, tenantSettings, notifyCompletion, this);
+        shardHost->start();
+    }
+    return true;
+}
+// Wake the event loop from a shard worker thread
+void SchedulerDaemon::notifyCompletion(void* context) {
+    SchedulerDaemon* daemon = (SchedulerDaemon*)context;
+    uint64_t one = 1;
+    ssize_t ignored = write(daemon->completionFd, &one, sizeof(one));
+    (void)ignored;
+}
+// Move finished worker responses to their connections
+void SchedulerDaemon::deliverCompleted() {
+    uint64_t counter;
+    ssize_t ignored = read(completionFd, &counter, sizeof(counter));
+    (void)ignored;
+    ShardRequest* request = shardHost->collectCompleted();
+    // Append every response first, then flush each touched connection once
+    DaemonConnection* touchedHead = nullptr;
+    while (request) {
+        ShardRequest* nextRequest = request->next;
+        DaemonConnection* connection = (DaemonConnection*)request->owner;
+        connection->requestsInFlight--;
+        if (!connection->isClosed) {
+            connection->outputBuffer.appendBytes(request->response.readPointer(),
+                                                 request->response.readableBytes());
+            if (!connection->isTouched) {
+                connection->isTouched = true;
+                connection->nextTouched = touchedHead;
+                touchedHead = connection;
+            }
+        }
+        delete request;
+        request = nextRequest;
+    }
+    while (touchedHead) {
+        DaemonConnection* connection = touchedHead;
+        touchedHead = touchedHead->nextTouched;
+        connection->isTouched = false;
+        handleEvents(connection, 0);
+    }
+}
+// Event loop, runs until SIGINT or SIGTERM
+void SchedulerDaemon::run() {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handleDaemonStopSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+    
+    epoll_event events[64];
+    while (!daemonStopRequested) {
+        int eventCount = epoll_wait(epollFd, events, 64, -1);
+        if (eventCount < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            cout << "Error: epoll_wait failed: " << strerror(errno) << endl;
+            break;
+        }
+        for (int i = 0; i < eventCount; i++) {
+            if (events[i].data.ptr == &listenerTag) {
+                acceptConnections();
+            } else if (events[i].data.ptr == &completionTag) {
+                deliverCompleted();
+            } else {
+                // Skip events of a connection closed earlier in this batch
+                DaemonConnection* connection = (DaemonConnection*)events[i].data.ptr;
+                if (!connection->isClosed) {
+                    handleEvents(connection, events[i].events);
+                }
+            }
+        }
+        // No event of this batch refers to a closed connection any more
+        releaseClosedConnections();
+    }
+}
+// Accept every pending client connection
+void SchedulerDaemon::acceptConnections() {
+    while (true) {
+        int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            return;
+        }
+        DaemonConnection* connection = new DaemonConnection(clientFd);
+        connection->next = connectionsHead;
+        if (connectionsHead) {
+            connectionsHead->previous = connection;
+        }
+        connectionsHead = connection;
+        epoll_event event;
+        memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.ptr = connection;
+        connection->eventMask = EPOLLIN;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, clientFd, &event) != 0) {
+            closeConnection(connection);
+        }
+    }
+}
+// Read requests, run them and send the responses
+void SchedulerDaemon::handleEvents(DaemonConnection* connection, unsigned int events) {
+    bool isOpen = true;
+    if (events & (EPOLLERR | EPOLLHUP)) {
+        isOpen = (events & EPOLLIN) != 0;
+    }
+    if (isOpen && (events & EPOLLIN)) {
+        isOpen = readInput(connection);
+    }
+    // Process everything buffered, this is what makes pipelining cheap:
+    // one read can carry many requests and one write carries all replies
+    if (isOpen) {
+        isOpen = processFrames(connection) && flushOutput(connection) &&
+                 processFrames(connection) && updateEventMask(connection);
+    }
+    // After a half-close, stay open until every buffered request is answered
+    if (isOpen && connection->isInputClosed && connection->requestsInFlight == 0 &&
+        connection->outputBuffer.readableBytes() == 0) {
+        isOpen = false;
+    }
+    if (!isOpen) {
+        closeConnection(connection);
+    }
+}
+// Read all available bytes, false on a read error. End of input only marks the
+// connection, the requests read before it are still answered.
+bool SchedulerDaemon::readInput(DaemonConnection* connection) {
+    while (true) {
+        char* space = connection->inputBuffer.reserveTail(65536);
+        ssize_t bytesRead = read(connection->socketFd, space, 65536);
+        if (bytesRead > 0) {
+            connection->inputBuffer.commitTail(bytesRead);
+        } else if (bytesRead == 0) {
+            connection->isInputClosed = true;
+            return true;
+        } else {
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+}
+// Execute complete frames until input runs out or output is backed up
+bool SchedulerDaemon::processFrames(DaemonConnection* connection) {
+    ByteBuffer& input = connection->inputBuffer;
+    int frameLength = 0, opcode;
+    unsigned int requestId;
+    unsigned int tenantId;
+    while (connection->outputBuffer.readableBytes() < MAX_PENDING_OUTPUT &&
+           connection->requestsInFlight < MAX_REQUESTS_IN_FLIGHT &&
+           peekFrame(input, frameLength, opcode, requestId, tenantId)) {
+        const char* body = input.readPointer() + FRAME_PREFIX_SIZE + FRAME_HEADER_SIZE;
+        int bodyLength = frameLength - FRAME_HEADER_SIZE;
+        if (shardHost) {
+            shardHost->submitRequest(new ShardRequest(opcode, requestId, tenantId, body, bodyLength, connection));
+            connection->requestsInFlight++;
+        } else {
+            TaskManager* manager = tenants->getManager(tenantId);
+            if (manager) {
+                processRequestFrame(*manager, opcode, requestId, tenantId,
+                                    body, bodyLength, connection->outputBuffer);
+            } else {
+                appendStatusResponse(connection->outputBuffer, opcode, requestId, tenantId, STATUS_TENANT_LIMIT);
+            }
+        }
+        input.consumeBytes(FRAME_PREFIX_SIZE + frameLength);
+    }
+    if (shardHost) {
+        shardHost->flushSubmissions();
+    }
+    return frameLength >= 0;
+}
+// Write as much buffered output as the socket accepts
+bool SchedulerDaemon::flushOutput(DaemonConnection* connection) {
+    ByteBuffer& output = connection->outputBuffer;
+    while (output.readableBytes() > 0) {
+        ssize_t bytesWritten = write(connection->socketFd, output.readPointer(), output.readableBytes());
+        if (bytesWritten > 0) {
+            output.consumeBytes(bytesWritten);
+        } else {
+            return bytesWritten < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+    }
+    return true;
+}
+// Register interest in input unless the client is backed up or done sending, and
+// in output while any is left
+bool SchedulerDaemon::updateEventMask(DaemonConnection* connection) {
+    int pendingOutput = connection->outputBuffer.readableBytes();
+    unsigned int wantedMask = 0;
+    if (!connection->isInputClosed && pendingOutput < MAX_PENDING_OUTPUT &&
+        connection->requestsInFlight < MAX_REQUESTS_IN_FLIGHT) {
+        wantedMask |= EPOLLIN;
+    }
+    if (pendingOutput > 0) {
+        wantedMask |= EPOLLOUT;
+    }
+    if (wantedMask == connection->eventMask) {
+        return true;
+    }
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = wantedMask;
+    event.data.ptr = connection;
+    // Registered since it was accepted, even while the mask is empty
+    connection->eventMask = wantedMask;
+    return epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->socketFd, &event) == 0;
+}
+// Remove a connection from a doubly linked connection list
+void SchedulerDaemon::unlinkConnection(DaemonConnection*& listHead, DaemonConnection* connection) {
+    if (connection->previous) {
+        connection->previous->next = connection->next;
+    } else {
+        listHead = connection->next;
+    }
+    if (connection->next) {
+        connection->next->previous = connection->previous;
+    }
+    connection->previous = nullptr;
+    connection->next = nullptr;
+}
+// Close a client connection. The object is only parked on the closing list: later
+// events of the same batch and unanswered worker requests may still point at it.
+void SchedulerDaemon::closeConnection(DaemonConnection* connection) {
+    unlinkConnection(connectionsHead, connection);
+    close(connection->socketFd);
+    connection->isClosed = true;
+    connection->next = closingHead;
+    if (closingHead) {
+        closingHead->previous = connection;
+    }
+    closingHead = connection;
+}
+// Free closed connections that no worker request refers to any more
+void SchedulerDaemon::releaseClosedConnections() {
+    DaemonConnection* connection = closingHead;
+    while (connection) {
+        DaemonConnection* nextConnection = connection->next;
+        if (connection->requestsInFlight == 0) {
+            unlinkConnection(closingHead, connection);
+            delete connection;
+        }
+        connection = nextConnection;
+    }
+}
+// CLIENT HELPERS
+// Connect to a daemon, returns the socket or -1
+int connectToDaemon(const char* socketPath) {
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+    int socketFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socketFd < 0 || connect(socketFd, (sockaddr*)&address, sizeof(address)) < 0) {
+        cout << "Error: Could not connect to " << socketPath << ": " << strerror(errno) << endl;
+        if (socketFd >= 0) {
+            close(socketFd);
+        }
+        return -1;
+    }
+    return socketFd;
+}
+// Write the whole buffer to a blocking socket
+bool sendBuffer(int socketFd, ByteBuffer& buffer) {
+    while (buffer.readableBytes() > 0) {
+        ssize_t bytesWritten = write(socketFd, buffer.readPointer(), buffer.readableBytes());
+        if (bytesWritten <= 0) {
+            return false;
+        }
+        buffer.consumeBytes(bytesWritten);
+    }
+    return true;
+}
+// Read from a blocking socket until a complete frame is buffered
+bool receiveFrame(int socketFd, ByteBuffer& inbox, int& frameLength, int& opcode,
+                  unsigned int& requestId, unsigned int& tenantId) {
+    while (!peekFrame(inbox, frameLength, opcode, requestId, tenantId)) {
+        if (frameLength < 0) {
+            return false;
+        }
+        char* space = inbox.reserveTail(65536);
+        ssize_t bytesRead = read(socketFd, space, 65536);
+        if (bytesRead <= 0) {
+            return false;
+        }
+        inbox.commitTail(bytesRead);
+    }
+    return true;
+}
+// Print the meaning of a response status
+const char* describeStatus(int status) {
+    switch (status) {
+        case STATUS_OK: return "OK";
+        case STATUS_NOT_FOUND: return "Task not found";
+        case STATUS_INVALID: return "Invalid task values";
+        case STATUS_NOTHING_TO_UNDO: return "Nothing to undo";
+        case STATUS_TENANT_LIMIT: return "Tenant limit reached";
+        default: return "Bad request";
+    }
+}
+// Send one command from the command line and print the reply
+int runClient(const char* socketPath, int argc, char* argv[]) {
+    unsigned int tenantId = 0;
+    if (argc >= 2 && strcmp(argv[0], "--tenant") == 0) {
+        tenantId = strtoul(argv[1], nullptr, 10);
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc < 1) {
+        cout << "Usage: --client <socket> [--tenant <id>] create <name> <priority> <deadline> <duration> | "
+             << "update <id> <name|-> <priority> <deadline> <duration> | delete <id> | "
+             << "schedule <id> | schedule-all | undo | get <id> | stats" << endl;
+        return 1;
+    }
+    const char* command = argv[0];
+    ByteBuffer request;
+    int framePosition;
+    if (strcmp(command, "create") == 0 && argc == 5) {
+        framePosition = beginFrame(request, OP_CREATE, 1, tenantId);
+        appendTaskRecord(request, argv[1], atoi(argv[2]), atoi(argv[3]), atoi(argv[4]));
+    } else if (strcmp(command, "update") == 0 && argc == 6) {
+        framePosition = beginFrame(request, OP_UPDATE, 1, tenantId);
+        request.appendU32(atoi(argv[1]));
+        appendTaskRecord(request, strcmp(argv[2], "-") == 0 ? "" : argv[2],
+                         atoi(argv[3]), atoi(argv[4]), atoi(argv[5]));
+    } else if (strcmp(command, "delete") == 0 && argc == 2) {
+        framePosition = beginFrame(request, OP_DELETE, 1, tenantId);
+        request.appendU32(atoi(argv[1]));
+    } else if (strcmp(command, "schedule") == 0 && argc == 2) {
+        framePosition = beginFrame(request, OP_SCHEDULE, 1, tenantId);
+        request.appendU32(atoi(argv[1]));
+    } else if (strcmp(command, "schedule-all") == 0) {
+        framePosition = beginFrame(request, OP_SCHEDULE_ALL, 1, tenantId);
+    } else if (strcmp(command, "undo") == 0) {
+        framePosition = beginFrame(request, OP_UNDO, 1, tenantId);
+    } else if (strcmp(command, "get") == 0 && argc == 2) {
+        framePosition = beginFrame(request, OP_QUERY_TASK, 1, tenantId);
+        request.appendU32(atoi(argv[1]));
+    } else if (strcmp(command, "stats") == 0) {
+        framePosition = beginFrame(request, OP_QUERY_STATS, 1, tenantId);
+    } else {
+        cout << "Error: Unknown command or wrong number of arguments: " << command << endl;
+        return 1;
+    }
+    endFrame(request, framePosition);
+    
+    int socketFd = connectToDaemon(socketPath);
+    if (socketFd < 0) {
+        return 1;
+    }
+    ByteBuffer inbox;
+    int frameLength, opcode;
+    unsigned int requestId, replyTenantId;
+    if (!sendBuffer(socketFd, request) ||
+        !receiveFrame(socketFd, inbox, frameLength, opcode, requestId, replyTenantId)) {
+        cout << "Error: Connection to daemon lost." << endl;
+        close(socketFd);
+        return 1;
+    }
+    close(socketFd);
+    
+    FrameReader reader(inbox.readPointer() + FRAME_PREFIX_SIZE + FRAME_HEADER_SIZE,
+                       frameLength - FRAME_HEADER_SIZE);
+    int status = STATUS_BAD_REQUEST;
+    reader.readU8(status);
+    if (status != STATUS_OK) {
+        cout << "Error: " << describeStatus(status) << endl;
+        return 1;
+    }
+    unsigned int first = 0, second = 0, third = 0;
+    int flag = 0;
+    Task record;
+    switch (opcode) {
+        case OP_CREATE:
+            reader.readU32(first);
+            cout << "Task created with ID " << first << endl;
+            break;
+        case OP_UPDATE:
+            cout << "Task updated successfully!" << endl;
+            break;
+        case OP_DELETE:
+            cout << "Task deleted successfully!" << endl;
+            break;
+        case OP_SCHEDULE:
+            reader.readU8(flag);
+            cout << (flag ? "Task scheduled successfully!" : "Task moved to pending list.") << endl;
+            break;
+        case OP_SCHEDULE_ALL:
+            reader.readU32(first);
+            reader.readU32(second);
+            cout << "Tasks scheduled: " << first << endl;
+            cout << "Tasks pending due to conflicts: " << second << endl;
+            break;
+        case OP_UNDO:
+            reader.readU32(first);
+            reader.readU8(flag);
+            cout << "Undid task " << first << (flag ? ", moved to pending list." : ", not found in scheduled list.") << endl;
+            break;
+        case OP_QUERY_TASK:
+            reader.readU32(first);
+            readTaskRecord(reader, record);
+            record.id = first;
+            record.displayTask(1);
+            break;
+        case OP_QUERY_STATS:
+            reader.readU32(first);
+            reader.readU32(second);
+            reader.readU32(third);
+            cout << "All tasks: " << first << " | Scheduled: " << second << " | Pending: " << third << endl;
+            break;
+        default:
+            cout << "OK" << endl;
+    }
+    return 0;
+}
+// Flood a daemon with pipelined create requests, spread over tenants, and report the throughput
+int runLoadGenerator(const char* socketPath, int totalRequests, int pipelineDepth, int batchSize, int tenantCount) {
+    if (totalRequests < 1 || pipelineDepth < 1 || batchSize < 1 || batchSize > MAX_BATCH_TASKS || tenantCount < 1) {
+        cout << "Usage: --loadgen <socket> <requests> [pipeline depth] [tasks per batch, 1-"
+             << MAX_BATCH_TASKS << "] [tenants]" << endl;
+        return 1;
+    }
+    int socketFd = connectToDaemon(socketPath);
+    if (socketFd < 0) {
+        return 1;
+    }
+    ByteBuffer outbox, inbox;
+    int sentCount = 0, completedCount = 0, failedCount = 0;
+    long long createdTasks = 0;
+    char taskName[32];
+    auto startTime = chrono::steady_clock::now();
+    
+    while (completedCount < totalRequests) {
+        // Keep the pipeline full
+        while (sentCount < totalRequests && sentCount - completedCount < pipelineDepth) {
+            int framePosition;
+            unsigned int tenantId = sentCount % tenantCount;
+            if (batchSize == 1) {
+                framePosition = beginFrame(outbox, OP_CREATE, sentCount, tenantId);
+            } else {
+                framePosition = beginFrame(outbox, OP_CREATE_BATCH, sentCount, tenantId);
+                outbox.appendU16(batchSize);
+            }
+            for (int i = 0; i < batchSize; i++) {
+                int sequence = sentCount * batchSize + i;
+                snprintf(taskName, sizeof(taskName), "load-task-%d", sequence);
+                appendTaskRecord(outbox, taskName, sequence % 5 + 1, sequence % 30 + 1, sequence % 24 + 1);
+            }
+            endFrame(outbox, framePosition);
+            sentCount++;
+        }
+        if (!sendBuffer(socketFd, outbox)) {
+            cout << "Error: Connection to daemon lost." << endl;
+            close(socketFd);
+            return 1;
+        }
+        // Collect at least one response, then everything else already received
+        int frameLength, opcode;
+        unsigned int requestId, tenantId;
+        if (!receiveFrame(socketFd, inbox, frameLength, opcode, requestId, tenantId)) {
+            cout << "Error: Connection to daemon lost." << endl;
+            close(socketFd);
+            return 1;
+        }
+        do {
+            FrameReader reader(inbox.readPointer() + FRAME_PREFIX_SIZE + FRAME_HEADER_SIZE,
+                               frameLength - FRAME_HEADER_SIZE);
+            int status = STATUS_BAD_REQUEST;
+            reader.readU8(status);
+            if (status == STATUS_OK) {
+                createdTasks += batchSize;
+            } else {
+                failedCount++;
+            }
+            inbox.consumeBytes(FRAME_PREFIX_SIZE + frameLength);
+            completedCount++;
+        } while (peekFrame(inbox, frameLength, opcode, requestId, tenantId));
+    }
+    double elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+    close(socketFd);
+    
+    cout << "Requests completed: " << completedCount << " (" << failedCount << " failed)" << endl;
+    cout << "Tasks created: " << createdTasks << endl;
+    cout << "Elapsed time: " << elapsedSeconds << " s" << endl;
+    cout << "Throughput: " << (long long)(completedCount / elapsedSeconds) << " requests/s, "
+         << (long long)(createdTasks / elapsedSeconds) << " tasks/s" << endl;
+    return 0;
+}
+// Map a published task view read-only and print one consistent snapshot of it.
+// The records are formatted straight from the mapping, the text is only kept
+// if the writer did not touch the view meanwhile.
+int runSharedViewReader(const char* name) {
+    char segmentName[256];
+    snprintf(segmentName, sizeof(segmentName), "%s%s", name[0] == '/' ? "" : "/", name);
+    int fd = shm_open(segmentName, O_RDONLY, 0);
+    if (fd < 0) {
+        cout << "Error: Could not open shared view " << segmentName << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    struct stat segmentInfo;
+    if (fstat(fd, &segmentInfo) != 0 || (size_t)segmentInfo.st_size < sizeof(SharedViewHeader)) {
+        cout << "Error: " << segmentName << " is not a task view." << endl;
+        close(fd);
+        return 1;
+    }
+    size_t mappedSize = segmentInfo.st_size;
+    void* memory = mmap(nullptr, mappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        cout << "Error: Could not map " << segmentName << ": " << strerror(errno) << endl;
+        return 1;
+    }
+    SharedViewHeader* header = (SharedViewHeader*)memory;
+    const SharedTaskRecord* records = (const SharedTaskRecord*)(header + 1);
+    unsigned int recordLimit = (mappedSize - sizeof(SharedViewHeader)) / sizeof(SharedTaskRecord);
+    if (header->magic != SHARED_VIEW_MAGIC || header->layoutVersion != SHARED_VIEW_LAYOUT) {
+        cout << "Error: " << segmentName << " is not a task view of this version." << endl;
+        munmap(memory, mappedSize);
+        return 1;
+    }
+    ByteBuffer output;
+    int retryCount = 0;
+    while (true) {
+        if (retryCount >= MAX_SHARED_VIEW_RETRIES) {
+            cout << "Error: " << segmentName << " kept changing, gave up after "
+                 << retryCount << " retries." << endl;
+            munmap(memory, mappedSize);
+            return 1;
+        }
+        unsigned int sequence = header->sequence.load(memory_order_acquire);
+        if (sequence & 1) {
+            // An owner that died mid-update leaves the counter odd for good
+            if (kill((pid_t)header->ownerPid, 0) != 0 && errno == ESRCH) {
+                cout << "Error: The scheduler owning " << segmentName
+                     << " exited while updating it." << endl;
+                munmap(memory, mappedSize);
+                return 1;
+            }
+            retryCount++;
+            if (retryCount < SHARED_VIEW_SPIN_RETRIES) {
+                this_thread::yield();
+            } else {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+            continue;
+        }
+        output.consumeBytes(output.readableBytes());
+        unsigned int highestId = header->highestId;
+        if (highestId > recordLimit) {
+            highestId = recordLimit;
+        }
+        char* line = output.reserveTail(256);
+        output.commitTail(snprintf(line, 256,
+                                   "All tasks: %u | Scheduled: %u | Pending: %u%s\n",
+                                   header->allCount, header->scheduledCount, header->pendingCount,
+                                   header->isTruncated ? " | Truncated: yes" : ""));
+        for (int state = TASK_STATE_SCHEDULED; state <= TASK_STATE_PENDING; state++) {
+            line = output.reserveTail(64);
+            output.commitTail(snprintf(line, 64, "\n=== %s TASKS ===\n",
+                                       state == TASK_STATE_SCHEDULED ? "SCHEDULED" : "PENDING"));
+            int taskNumber = 1;
+            for (unsigned int i = 0; i < highestId; i++) {
+                const SharedTaskRecord& record = records[i];
+                if (record.id == 0 || record.state != state) {
+                    continue;
+                }
+                line = output.reserveTail(256);
+                output.commitTail(snprintf(line, 256,
+                                           "  %d. [ID:%d] %.*s | Priority: %d | Deadline: %d days | Duration: %d hours\n",
+                                           taskNumber++, record.id, (int)strnlen(record.name, sizeof(record.name)),
+                                           record.name, record.priority, record.deadline, record.duration));
+            }
+        }
+        atomic_thread_fence(memory_order_acquire);
+        if (header->sequence.load(memory_order_relaxed) == sequence) {
+            break;
+        }
+        retryCount++;
+    }
+    fwrite(output.readPointer(), 1, output.readableBytes(), stdout);
+    if (retryCount > 0) {
+        cout << "(" << retryCount << " retries while the scheduler was writing)" << endl;
+    }
+    munmap(memory, mappedSize);
+    return 0;
+}
+// Host tenant TaskManagers behind a Unix domain socket, on worker threads if requested
+int runDaemon(const char* socketPath, int workerThreads, TenantSettings* settings) {
+    if (workerThreads < 0) {
+        cout << "Error: Worker thread count cannot be negative." << endl;
+        return 1;
+    }
+    SchedulerDaemon daemon(socketPath, settings);
+    if (!daemon.start(workerThreads)) {
+        return 1;
+    }
+    cout << "Scheduler daemon listening on " << socketPath;
+    if (workerThreads > 0) {
+        cout << " with " << workerThreads << " shard worker threads";
+    }
+    cout << " (Ctrl+C to stop)" << endl;
+    daemon.run();
+    cout << "Scheduler daemon stopped." << endl;
+    return 0;
+}
+#endif
+// Handle the non-interactive modes selected on the command line
+int runCommandLineMode(int argc, char* argv[]) {
+#ifdef __linux__
+    if (strcmp(argv[1], "--daemon") == 0 && argc >= 3) {
+        // Optional worker thread count, then optional --max-tenants <count> and
+        // --shm <prefix> <tenant ID>... (the tenant IDs run to the end of the line)
+        TenantSettings settings;
+        int workerThreads = 0;
+        int nextArgument = 3;
+        if (argc > 3 && strncmp(argv[3], "--", 2) != 0) {
+            workerThreads = atoi(argv[3]);
+            nextArgument = 4;
+        }
+        bool isValid = true;
+        while (isValid && nextArgument < argc) {
+            if (strcmp(argv[nextArgument], "--max-tenants") == 0 && nextArgument + 1 < argc) {
+                settings.maxTenants = atoi(argv[nextArgument + 1]);
+                isValid = settings.maxTenants > 0;
+                nextArgument += 2;
+            } else if (strcmp(argv[nextArgument], "--shm") == 0 && nextArgument + 2 < argc) {
+                settings.sharedViewPrefix = argv[nextArgument + 1];
+                settings.sharedViewTenantCount = argc - nextArgument - 2;
+                settings.sharedViewTenantIds = new unsigned int[settings.sharedViewTenantCount];
+                for (int i = 0; i < settings.sharedViewTenantCount; i++) {
+                    const char* text = argv[nextArgument + 2 + i];
+                    char* end;
+                    settings.sharedViewTenantIds[i] = strtoul(text, &end, 10);
+                    isValid = isValid && isdigit((unsigned char)text[0]) && *end == '\0';
+                }
+                nextArgument = argc;
+            } else {
+                isValid = false;
+            }
+        }
+        if (!isValid) {
+            cout << "Usage: " << argv[0] << " --daemon <socket> [worker threads] [--max-tenants <count>] "
+                 << "[--shm <prefix> <tenant ID>...]" << endl;
+            return 1;
+        }
+        return runDaemon(argv[2], workerThreads, &settings);
+    }
+    if (strcmp(argv[1], "--shm") == 0 && (argc == 3 || argc == 4)) {
+        TaskManager taskScheduler;
+        int capacity = argc == 4 ? atoi(argv[3]) : DEFAULT_SHARED_VIEW_CAPACITY;
+        if (!taskScheduler.enableSharedView(argv[2], capacity)) {
+            cout << "Error: Could not create shared view " << argv[2] << ": " << strerror(errno) << endl;
+            return 1;
+        }
+        taskScheduler.runScheduler();
+        return 0;
+    }
+    if (strcmp(argv[1], "--shm-reader") == 0 && argc == 3) {
+        return runSharedViewReader(argv[2]);
+    }
+    if (strcmp(argv[1], "--client") == 0 && argc >= 3) {
+        return runClient(argv[2], argc - 3, argv + 3);
+    }
+    if (strcmp(argv[1], "--loadgen") == 0 && argc >= 4) {
+        return runLoadGenerator(argv[2], atoi(argv[3]), argc > 4 ? atoi(argv[4]) : 64,
+                                argc > 5 ? atoi(argv[5]) : 1, argc > 6 ? atoi(argv[6]) : 1);
+    }
+    cout << "Usage: " << argv[0] << " [--daemon <socket> [worker threads] [--max-tenants <count>] [--shm <prefix> <tenant ID>...] | "
+         << "--client <socket> [--tenant <id>] <command> | "
+         << "--loadgen <socket> <requests> [pipeline depth] [tasks per batch] [tenants] | "
+         << "--shm <name> [capacity] | --shm-reader <name>]" << endl;
+#else
+    (void)argc;
+    (void)argv;
+    cout << "Daemon, client, load generator and shared view modes are only available on Linux." << endl;
+#endif
+    return 1;
+}
+// Apply the leading --log-level and --log-rate options to the scheduling log,
+// returns how many arguments they used, -1 if one is invalid
+int applyLogOptions(int argc, char* argv[]) {
+    int used = 0;
+    while (used + 2 < argc) {
+        const char* option = argv[used + 1];
+        const char* value = argv[used + 2];
+        if (strcmp(option, "--log-level") == 0) {
+            if (strcmp(value, "debug") == 0) {
+                schedulerLog().setMinimumLevel(LOG_DEBUG);
+            } else if (strcmp(value, "info") == 0) {
+                schedulerLog().setMinimumLevel(LOG_INFO);
+            } else if (strcmp(value, "quiet") == 0) {
+                schedulerLog().setMinimumLevel(LOG_QUIET);
+            } else {
+                return -1;
+            }
+        } else if (strcmp(option, "--log-rate") == 0) {
+            if (!isdigit((unsigned char)value[0])) {
+                return -1;
+            }
+            schedulerLog().setRateLimit(atoi(value));
+        } else {
+            break;
+        }
+        used += 2;
+    }
+    return used;
+}
+// MAIN FUNCTION
+int main(int argc, char* argv[]) {
+    // Log options come first and apply to every mode
+    int logArguments = applyLogOptions(argc, argv);
+    if (logArguments < 0) {
+        cout << "Usage: " << argv[0] << " [--log-level <debug|info|quiet>] [--log-rate <messages per second, 0 = unlimited>] [mode]" << endl;
+        return 1;
+    }
+    if (logArguments > 0) {
+        char* programName = argv[0];
+        argc -= logArguments;
+        argv += logArguments;
+        argv[0] = programName;
+    }
+    // Daemon, client, load generator and shared view modes
+    if (argc > 1) {
+        return runCommandLineMode(argc, argv);
+    }
     // Create task manager instance
     TaskManager taskScheduler;
     // Run the scheduler